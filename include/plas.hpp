@@ -2,6 +2,11 @@
 #define PLAS_HPP_
 
 #include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <vector>
 #include <map>
@@ -9,6 +14,12 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #ifndef plas_VARTYPE
 # 	define plas_VARTYPE int
@@ -18,6 +29,13 @@
 #	define plas_UVARTYPE unsigned plas_VARTYPE
 #endif
 
+namespace plas {
+template <typename T> struct OctDiffConstraint;
+}
+
+// Used by the problem conversions below, which log their constraints
+template <typename T> std::ostream& operator<<(std::ostream& os, const plas::OctDiffConstraint<T>& oct);
+
 namespace plas {
 
 //static const char _assert_vartypesize_le_sizet[sizeof(size_t) - sizeof(plas_VARTYPE) - 1] = {};
@@ -76,6 +94,20 @@ template <typename T> struct IMatrix {
 };
 
 
+/*
+ * Destination of the difference bound matrix of a problem streamed by
+ * openOctDiff(). resize() is called with the number of rows once the
+ * problem line is read, and may refuse it; then tighten() is called with
+ * each difference constraint, as 1-based row and column, and only the
+ * smallest constant of each cell is meant to be kept.
+ */
+template <typename T> struct IOctDiffSink {
+	virtual ~IOctDiffSink() {}
+	virtual bool resize(var_t diffSize) = 0;
+	virtual void tighten(var_t row, var_t col, T d) = 0;
+};
+
+
 /*
  * [ [ [ AUXILIARY FUNCTIONS ] ] ]
  */
@@ -226,7 +258,7 @@ public:
 			var_t b = OctDiffConstraint<T>::b();
 
 			if (a < 0 && b > 0) {
-				var_t t = a; a = b; b = a;
+				var_t t = a; a = b; b = t;
 			}
 
 			var_t newa = generateTransformedVar(a);
@@ -384,7 +416,190 @@ private:
 };
 
 
-template <typename T, template <typename T> class M = DenseMatrix> struct Problem {
+/*
+ * Open-addressing hash table from variables to indices, with linear probing.
+ */
+class VarIndex {
+public:
+	static const size_t npos = static_cast<size_t>(-1);
+
+	VarIndex() :
+		_size(0) {}
+	size_t size() const
+		{ return _size; }
+	size_t find(var_t var) const {
+		if (_size == 0)
+			return npos;
+		for (size_t slot = hash(var);; slot = (slot + 1) & (_slots.size() - 1)) {
+			if (_slots[slot].value == npos || _slots[slot].var == var)
+				return _slots[slot].value;
+		}
+	}
+	void insert(var_t var, size_t value) {
+		if (2 * (_size + 1) > _slots.size())
+			rehash(_slots.empty() ? 16 : 2 * _slots.size());
+		size_t slot = hash(var);
+		while (_slots[slot].value != npos && _slots[slot].var != var)
+			slot = (slot + 1) & (_slots.size() - 1);
+		if (_slots[slot].value == npos)
+			++_size;
+		_slots[slot].var = var;
+		_slots[slot].value = value;
+	}
+	void clear() {
+		_slots.clear();
+		_size = 0;
+	}
+
+private:
+	struct Slot {
+		Slot() :
+			var(INVALID_VAR),
+			value(npos) {}
+		var_t var;
+		size_t value; // npos for empty slots
+	};
+
+	size_t hash(var_t var) const
+		{ return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(var)) * 0x9E3779B97F4A7C15ull) >> 32) & (_slots.size() - 1); }
+	void rehash(size_t capacity) {
+		std::vector<Slot> slots(capacity);
+		slots.swap(_slots);
+		_size = 0;
+		for (size_t slot = 0; slot < slots.size(); ++slot)
+			if (slots[slot].value != npos)
+				insert(slots[slot].var, slots[slot].value);
+	}
+
+	std::vector<Slot> _slots;
+	size_t _size;
+};
+
+
+/*
+ * Declared names of variables. Names are interned in a single arena of
+ * characters and indexed by variable (see VarIndex), instead of each being
+ * a string of its own. Names of the variables of a transformed problem
+ * (see derive()) only refer to the name they derive from, and are put
+ * together when asked for. An empty table allocates nothing.
+ *
+ * Names are numbered in the order they were first set.
+ */
+class NameTable {
+public:
+	static const size_t npos = VarIndex::npos;
+
+	size_t size() const
+		{ return _records.size(); }
+	bool empty() const
+		{ return _records.empty(); }
+	void clear() {
+		_records.clear();
+		_arena.clear();
+		_index.clear();
+		_bases.clear();
+		_baseSpans.clear();
+	}
+	/* Number of the name of var, or npos. */
+	size_t find(var_t var) const
+		{ return _index.find(var); }
+	var_t var(size_t idx) const
+		{ return _records[idx].var; }
+	size_t fileline(size_t idx) const
+		{ return _records[idx].fileline; }
+	std::string name(size_t idx) const
+		{ std::string str; appendName(idx, str); return str; }
+	void appendName(size_t idx, std::string& str) const {
+		const Record& record = _records[idx];
+		if (record.length != npos)
+			str.append(_arena, record.offset, record.length);
+		else
+			appendNumber(str, record.source);
+		if (record.kind != 0) {
+			str += "__";
+			str += record.kind;
+			appendNumber(str, record.source);
+			str += '_';
+			appendNumber(str, record.var);
+		}
+	}
+	/* Sets the name of var, returning its number. */
+	size_t set(var_t var, const char* name, size_t length, size_t fileline = 0) {
+		Record record = { var, 0, _arena.size(), length, fileline, 0 };
+		_arena.append(name, length);
+		return add(record);
+	}
+	size_t set(var_t var, const std::string& name, size_t fileline = 0)
+		{ return set(var, name.data(), name.size(), fileline); }
+	/*
+	 * Names var after the positive or negative half of the (normalized)
+	 * variable source, whose name is looked up in from, as
+	 * `<name>__p<source>_<var>` or `<name>__n<source>_<var>`; variables
+	 * without a name are named after their number. The name of source is
+	 * copied at most once, however many variables derive from it.
+	 */
+	size_t derive(var_t var, var_t source, bool positive, const NameTable* from) {
+		size_t base = _bases.find(source);
+		if (base == npos) {
+			std::pair<size_t, size_t> span(_arena.size(), static_cast<size_t>(npos));
+			size_t idx = from != NULL && source != INVALID_VAR ? from->find(source) : npos;
+			if (idx != npos) {
+				from->appendName(idx, _arena);
+				span.second = _arena.size() - span.first;
+			}
+			base = _baseSpans.size();
+			_baseSpans.push_back(span);
+			_bases.insert(source, base);
+		}
+
+		Record record = { var, source, _baseSpans[base].first, _baseSpans[base].second, 0, static_cast<char>(positive ? 'p' : 'n') };
+		return add(record);
+	}
+
+private:
+	struct Record {
+		var_t var;
+		var_t source;
+		size_t offset;   // Of the name, or of the name derived from
+		size_t length;   // npos for names derived from a variable without one
+		size_t fileline;
+		char kind;       // 0, or 'p' or 'n' for derived names
+	};
+
+	size_t add(const Record& record) {
+		size_t idx = _index.find(record.var);
+		if (idx == npos) {
+			idx = _records.size();
+			_records.push_back(record);
+			_index.insert(record.var, idx);
+		} else {
+			_records[idx] = record;
+		}
+		return idx;
+	}
+	static void appendNumber(std::string& str, var_t var) {
+		char buffer[24];
+		char* end = buffer + sizeof(buffer);
+		char* begin = end;
+		unsigned long long n = var < 0 ? -static_cast<long long>(var) : var;
+		do {
+			*--begin = '0' + n % 10;
+			n /= 10;
+		} while (n != 0);
+		if (var < 0)
+			*--begin = '-';
+		str.append(begin, end);
+	}
+
+	std::vector<Record> _records;
+	std::string _arena;
+	VarIndex _index;
+	VarIndex _bases;                                  // Variables derived from, to their spans
+	std::vector<std::pair<size_t, size_t> > _baseSpans;
+};
+
+
+template <typename T, template <typename> class M = DenseMatrix> struct Problem {
 	typedef plas::OctDiffConstraint<T> OctConstraint;
 	typedef M<T> DefaultMatrix;
 
@@ -425,48 +640,14 @@ template <typename T, template <typename T> class M = DenseMatrix> struct Proble
 		OctConstraint _octConstraint;
 	};
 
-	struct NameEntry {
-		NameEntry() :
-			_normalizedVar(0),
-			_fileline(0) {}
-		NameEntry(const NameEntry& rhs) :
-			_name(rhs._name),
-			_normalizedVar(rhs._normalizedVar),
-			_fileline(rhs._fileline) {}
-		NameEntry(var_t var) :
-			_normalizedVar(normalizeVar(var)),
-			_fileline(0) {}
-		NameEntry(var_t var, const std::string& name, size_t fileline = 0) :
-			_normalizedVar(normalizeVar(var)),
-			_name(name),
-			_fileline(fileline) {}
-		NameEntry(var_t var, const char* name, size_t fileline = 0) :
-			_normalizedVar(normalizeVar(var)),
-			_name(name),
-			_fileline(fileline) {}
-		var_t& normalizedVar() { return _normalizedVar; }
-		NameEntry& normalizedVar(var_t var) { _normalizedVar = normalizeVar(var); return *this; }
-		std::string& name() { return _name; }
-		NameEntry& name(const std::string& name) { _name = name; return *this; }
-		NameEntry& name(const char* name) { _name = name; return *this; }
-		size_t& fileline() { return _fileline; }
-		NameEntry& fileline(size_t fileline) { _fileline = fileline; return *this; }
-
-	private:
-		var_t _normalizedVar;
-		std::string _name;
-		size_t _fileline;
-	};
-
 	// List containing all entries
 	typedef typename std::vector<Entry> EntryList;
 	typedef typename EntryList::iterator EntryListIterator;
 	// Map relating variable appearance with entries
 	typedef typename std::map<var_t, Entry> EntryMap;
 	typedef typename EntryMap::iterator EntryMapIterator;
-	// Map holding declared variable names
-	typedef typename std::map<var_t, NameEntry> NamesMap;
-	typedef typename NamesMap::iterator NamesMapIterator;
+	// Table holding declared variable names
+	typedef NameTable NamesMap;
 	// Set containing all declared variables
 	typedef typename std::set<var_t> VarSet;
 	typedef typename VarSet::iterator VarSetIterator;
@@ -574,14 +755,14 @@ template <typename T, template <typename T> class M = DenseMatrix> struct Proble
 		if (forceSign) s.setf(std::ios_base::showpos);
 		if (_names != NULL) {
 			var_t normalizedVar = normalizeVar(var);
-			NamesMapIterator it = _names->find(normalizedVar);
+			size_t idx = _names->find(normalizedVar);
 
-			if (var != plas::INVALID_VAR && it != _names->end()) {
+			if (var != plas::INVALID_VAR && idx != NamesMap::npos) {
 				if (var < 0)
 					s << "-";
 				else if (forceSign && var > 0)
 					s << "+";
-				s << it->second.name();
+				s << _names->name(idx);
 			} else
 				s << var;
 		} else
@@ -632,21 +813,762 @@ private:
 };
 
 
+/*
+ * Streams a difference bound matrix into any matrix, whose cells are all
+ * set to its default value on resize(). Matrices which can't be resized,
+ * such as a DenseMatrix over a raw buffer, must be large enough already.
+ * Constraints out of the matrix are ignored.
+ */
+template <typename T> class MatrixOctDiffSink : public IOctDiffSink<T> {
+public:
+	explicit MatrixOctDiffSink(IMatrix<T>& matrix) :
+		_matrix(matrix),
+		_diffSize(0) {}
+	bool resize(var_t diffSize) {
+		_matrix.resize(diffSize, diffSize);
+		if (diffSize <= 0 || _matrix.rowsize() < diffSize || _matrix.colsize() < diffSize)
+			return false;
+		_diffSize = diffSize;
+		for (var_t row = 1; row <= diffSize; ++row)
+			for (var_t col = 1; col <= diffSize; ++col)
+				_matrix(row, col) = _matrix.defaultVal();
+		return true;
+	}
+	void tighten(var_t row, var_t col, T d) {
+		if (row <= _diffSize && col <= _diffSize) {
+			T& cell = _matrix(row, col);
+			if (d < cell) cell = d;
+		}
+	}
+
+private:
+	IMatrix<T>& _matrix;
+	var_t _diffSize;
+};
+
+
+/*
+ * [ [ [ TEXT PARSING ] ] ]
+ */
+
+
+/*
+ * Splits a stream into lines, reading it in large blocks rather than one
+ * line at a time. The line returned by next() (without its '\n') is only
+ * valid until the following call.
+ */
+class LineReader {
+public:
+	explicit LineReader(std::istream& is, size_t blockSize = 1 << 16) :
+		_is(is),
+		_buffer(blockSize),
+		_begin(0),
+		_end(0),
+		_eof(false) {}
+	bool next(const char*& begin, const char*& end) {
+		for (;;) {
+			const char* data = &_buffer[0];
+			const char* nl = static_cast<const char*>(std::memchr(data + _begin, '\n', _end - _begin));
+
+			if (nl != NULL) {
+				begin = data + _begin;
+				end = nl;
+				_begin = nl - data + 1;
+				return true;
+
+			} else if (_eof) {
+				// Last line, without a trailing '\n'
+				begin = data + _begin;
+				end = data + _end;
+				_begin = _end;
+				return begin != end;
+			}
+
+			fill();
+		}
+	}
+
+private:
+	LineReader(const LineReader&);
+	LineReader& operator=(const LineReader&);
+
+	void fill() {
+		if (_begin > 0) {
+			std::memmove(&_buffer[0], &_buffer[_begin], _end - _begin);
+			_end -= _begin;
+			_begin = 0;
+		}
+		if (_end == _buffer.size())
+			_buffer.resize(2 * _buffer.size());
+
+		_is.read(&_buffer[_end], _buffer.size() - _end);
+		_end += _is.gcount();
+		if (_is.gcount() == 0)
+			_eof = true;
+	}
+
+	std::istream& _is;
+	std::vector<char> _buffer;
+	size_t _begin;
+	size_t _end;
+	bool _eof;
+};
+
+
+/*
+ * Whitespace-separated tokens of a line. Numbers are parsed in place, as
+ * std::istream would (i.e. each one is the longest valid prefix from the
+ * current position), without streams or locales. Decimal constants with
+ * up to 19 digits and no exponent, which are exact once scaled, are
+ * computed directly; others go through strtod and the like.
+ */
+class Tokenizer {
+public:
+	Tokenizer(const char* begin, const char* end) :
+		_pos(begin),
+		_end(end) {}
+	const char* pos() const
+		{ return _pos; }
+	char peek() const
+		{ return *_pos; }
+	static bool isSpace(char c)
+		{ return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+	void skipSpace()
+		{ while (_pos != _end && isSpace(*_pos)) ++_pos; }
+	bool atEnd()
+		{ skipSpace(); return _pos == _end; }
+	void skipToken()
+		{ const char* begin; const char* end; token(begin, end); }
+	bool token(const char*& begin, const char*& end) {
+		skipSpace();
+		begin = _pos;
+		while (_pos != _end && !isSpace(*_pos)) ++_pos;
+		end = _pos;
+		return begin != end;
+	}
+	template <typename V> bool parse(V& value) {
+		skipSpace();
+		return parse(value, std::integral_constant<bool, std::numeric_limits<V>::is_integer>());
+	}
+
+private:
+	static inline bool isDigit(char c)
+		{ return c >= '0' && c <= '9'; }
+
+	// Only the parser for V is instantiated, the other wouldn't compile cleanly
+	template <typename V> bool parse(V& value, std::true_type)
+		{ return parseInteger(value); }
+	template <typename V> bool parse(V& value, std::false_type)
+		{ return parseReal(value); }
+
+	template <typename V> bool parseInteger(V& value) {
+		const char* p = _pos;
+		bool negative = false;
+		unsigned long long n = 0;
+		unsigned long long limit = std::numeric_limits<V>::max();
+
+		if (p != _end && (*p == '-' || *p == '+'))
+			negative = *p++ == '-';
+		if (p == _end || !isDigit(*p) || (negative && !std::numeric_limits<V>::is_signed))
+			return false;
+		if (negative)
+			limit++;
+
+		for (; p != _end && isDigit(*p); ++p) {
+			n = 10 * n + (*p - '0');
+			if (n > limit)
+				return false;
+		}
+		// The whole token, so that `e 1 2.5` isn't taken for variables 1 and 2
+		if (p != _end && !isSpace(*p))
+			return false;
+
+		value = negative ? static_cast<V>(-static_cast<long long>(n)) : static_cast<V>(n);
+		_pos = p;
+		return true;
+	}
+
+	template <typename V> bool parseReal(V& value) {
+		const char* p = _pos;
+		bool negative = false;
+		unsigned long long mantissa = 0;
+		int digits = 0, fraction = 0;
+
+		if (p != _end && (*p == '-' || *p == '+'))
+			negative = *p++ == '-';
+		for (; p != _end && isDigit(*p) && digits < 19; ++p, ++digits)
+			mantissa = 10 * mantissa + (*p - '0');
+		if (p != _end && *p == '.')
+			for (++p; p != _end && isDigit(*p) && digits < 19; ++p, ++digits, ++fraction)
+				mantissa = 10 * mantissa + (*p - '0');
+
+		if (digits == 0 || (p != _end && (isDigit(*p) || *p == 'e' || *p == 'E'))
+				|| mantissa > exactMantissa<V>() || fraction > exactPow10<V>())
+			return parseRealSlow(value);
+
+		value = static_cast<V>(mantissa) / pow10<V>(fraction);
+		if (negative)
+			value = -value;
+		_pos = p;
+		return true;
+	}
+
+	template <typename V> bool parseRealSlow(V& value) {
+		const char* begin;
+		const char* end;
+		const char* start = _pos;
+		token(begin, end);
+		std::string s(begin, end);
+		char* last = NULL;
+		value = toReal(s.c_str(), &last, static_cast<V*>(NULL));
+		if (last == s.c_str()) {
+			_pos = start;
+			return false;
+		}
+		_pos = begin + (last - s.c_str());
+		return true;
+	}
+
+	static float toReal(const char* s, char** last, float*)
+		{ return std::strtof(s, last); }
+	static double toReal(const char* s, char** last, double*)
+		{ return std::strtod(s, last); }
+	static long double toReal(const char* s, char** last, long double*)
+		{ return std::strtold(s, last); }
+	template <typename V> static V toReal(const char* s, char** last, V*)
+		{ return static_cast<V>(std::strtold(s, last)); }
+
+	/* Largest mantissa which V represents exactly. */
+	template <typename V> static unsigned long long exactMantissa() {
+		int bits = std::numeric_limits<V>::digits < 63 ? std::numeric_limits<V>::digits : 63;
+		return 1ULL << bits;
+	}
+
+	/* Largest power of 10 which V represents exactly. */
+	template <typename V> static int exactPow10() {
+		static const int exact = [] {
+			int k = 0;
+			for (unsigned long long p = 1; p <= exactMantissa<V>() / 5; p *= 5)
+				++k;
+			return k;
+		}();
+		return exact;
+	}
+
+	template <typename V> static V pow10(int k) {
+		static const std::vector<V> table = [] {
+			std::vector<V> t(1, V(1));
+			for (int i = 1; i <= exactPow10<V>(); ++i)
+				t.push_back(t.back() * 10);
+			return t;
+		}();
+		return table[k];
+	}
+
+	const char* _pos;
+	const char* _end;
+};
+
+
+/* Calls f(i) for each i in [0, n), from up to numThreads threads (the calling one included). */
+template <typename F> static void parallelFor(size_t n, size_t numThreads, F f) {
+	std::atomic<size_t> next(0);
+	auto task = [&]() {
+		for (size_t i = next++; i < n; i = next++)
+			f(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < numThreads && t < n; ++t)
+		threads.push_back(std::thread(task));
+	task();
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+}
+
+
+/*
+ * The state of a text problem being parsed, with the handling of each kind
+ * of line. Lines must be given in order, but `e` lines may be tokenized
+ * beforehand (see parseEntry() and entry()).
+ *
+ * Given a sink, the difference bound matrix goes to it instead of to the
+ * problem's matrix, and entries are only kept in the problem if keepEntries.
+ */
+template <typename T, template <typename> class M> class TextParser {
+public:
+	TextParser(Problem<T, M>& problem, std::ostream* ls = NULL, IOctDiffSink<T>* sink = NULL, bool keepEntries = true) :
+		_problem(problem),
+		_ls(ls),
+		_sink(sink),
+		_keepEntries(keepEntries),
+		_numEntries(0),
+		_maxNormalizedVar(0)
+		{ problem.reset(); }
+
+	/* Whether `e` lines are taken as entries at this point. */
+	bool acceptsEntries() const
+		{ return _problem.problemType() == PROBLEM_OCT || _problem.problemType() == PROBLEM_OCTDIFF; }
+
+	/* Either `<var1> <var2> <constant>`, or `<var1> <constant>`. */
+	static bool parseEntry(Tokenizer& line, var_t& a, var_t& b, T& d) {
+		Tokenizer rest = line;
+		bool valid = line.parse(a);
+
+		if (valid && !(line.parse(b) && line.parse(d))) {
+			line = rest;
+			line.parse(a);
+			b = a;
+			valid = line.parse(d) && line.atEnd();
+		}
+
+		if (a == INVALID_VAR) a = b;
+		if (b == INVALID_VAR) b = a;
+		return valid;
+	}
+
+	void line(const char* begin, const char* end, size_t fileline) {
+		Tokenizer line(begin, end);
+
+		// ignores comments or empty lines
+		if (line.atEnd() || line.peek() == '#')
+			return;
+
+		if (_ls != NULL)
+			*_ls << std::string(line.pos(), end) << std::endl;
+
+		char firstChar = line.peek();
+		line.skipToken(); // remove 'n', 'e' or 'p'
+
+		if (firstChar == 'n' && _problem.problemType() != PROBLEM_NONE && _problem.names() != NULL) {
+			typename Problem<T, M>::NamesMap& names = *_problem.names();
+			var_t var;
+			const char* nameBegin;
+			const char* nameEnd;
+
+			if (line.parse(var)) {
+				// TODO: Warnings about variables with values above the declared variable names
+				// TODO: Warnings about negative variables
+				line.token(nameBegin, nameEnd);
+				names.set(var, nameBegin, nameEnd - nameBegin, fileline);
+			}
+
+		} else if (firstChar == 'e' && _problem.problemType() == PROBLEM_GRAPH
+				&& (_problem.declaredNumEntries() == 0 || _numEntries < _problem.declaredNumEntries())) {
+			// TODO: Edge lists (`e <vertice> [<vertice> <cost_constant>]...`)
+
+		} else if (firstChar == 'e' && acceptsEntries()) {
+			var_t a, b;
+			T d;
+			if (parseEntry(line, a, b, d))
+				entry(a, b, d, fileline);
+
+		} else if (firstChar == 'p') {
+			// Identify problem and parameters
+			const char* nameBegin;
+			const char* nameEnd;
+			bool valid = true;
+			line.token(nameBegin, nameEnd);
+			std::string problemName(nameBegin, nameEnd);
+
+			if (problemName.compare("octdiff") == 0) {
+				_problem
+					.problemType(PROBLEM_OCTDIFF)
+					.problemNature(PROBLEM_REAL);
+
+			} else if (problemName.compare("oct") == 0) {
+				_problem
+					.problemType(PROBLEM_OCT)
+					.problemNature(PROBLEM_REAL);
+
+			} else if (problemName.compare("octdiff_int") == 0) {
+				_problem
+					.problemType(PROBLEM_OCTDIFF)
+					.problemNature(PROBLEM_INT);
+
+			} else if (problemName.compare("oct_int") == 0) {
+				_problem
+					.problemType(PROBLEM_OCT)
+					.problemNature(PROBLEM_INT);
+			}
+
+			if (_problem.problemType() != PROBLEM_NONE) {
+				// Both counts are optional
+				size_t numEntries = 0, numVariables = 0;
+				if (!line.atEnd())
+					valid = line.parse(numVariables);
+				if (valid && !line.atEnd())
+					valid = line.parse(numEntries);
+				_problem
+					.declaredNumEntries(numEntries)
+					.declaredNumVars(numVariables)
+					.numVars(numVariables);
+				if (_keepEntries)
+					_problem.entries().reserve(numEntries);
+			}
+
+			if (valid && _sink != NULL) {
+				// The sink is sized up front, from the declared number of variables
+				if (_problem.problemType() != PROBLEM_NONE)
+					valid = _problem.declaredNumVars() > 0 && _sink->resize(_problem.problemType() == PROBLEM_OCT
+						? 2 * _problem.declaredNumVars()
+						: _problem.declaredNumVars());
+			} else if (valid) {
+				if (_problem.matrix() != NULL) _problem.matrix()->resize(
+					_problem.declaredNumVars(),
+					_problem.declaredNumVars());
+			}
+
+			if (!valid) {
+				_problem.reset();
+				_numEntries = 0;
+				_inserted.clear();
+			}
+		}
+	}
+
+	/* Adds an entry parsed from an `e` line, while acceptsEntries(). */
+	void entry(var_t a, var_t b, T d, size_t fileline) {
+		var_t na = normalizeVar(a);
+		var_t nb = normalizeVar(b);
+		typename Problem<T, M>::OctConstraint constraint(a, b, d);
+		typename Problem<T, M>::Entry entry(++_numEntries);
+		entry.octConstraint(constraint).fileline(fileline);
+
+		// Add to the
+		if (_keepEntries)
+			_problem.entries().push_back(entry);
+		if (a != INVALID_VAR) {
+			if (na > _maxNormalizedVar) _maxNormalizedVar = na;
+			if (_problem.vars() != NULL) insertVar(*_problem.vars(), _inserted, a);
+		}
+		if (b != INVALID_VAR) {
+			if (nb > _maxNormalizedVar) _maxNormalizedVar = nb;
+			if (_problem.vars() != NULL) insertVar(*_problem.vars(), _inserted, b);
+		}
+		_problem.minConstant(d).maxConstant(d);
+		if (_sink != NULL && _problem.problemType() == PROBLEM_OCT) {
+			OctDiffConstraint<T> ca, cb;
+			plas::OctConstraint<T>(a, b, d).split(ca, cb);
+			if (ca.valid()) _sink->tighten(ca.a(), ca.b(), ca.constant());
+			if (cb.valid()) _sink->tighten(cb.a(), cb.b(), cb.constant());
+		} else if (_sink != NULL && b > 0 && a > 0) {
+			_sink->tighten(a, b, d);
+		} else if (_problem.matrix() != NULL && b > 0 && a > 0) {
+			(*_problem.matrix())(a, b) = d;
+		}
+	}
+
+	/* Accounts for entries added to the problem without going through entry(). */
+	void entries(size_t numEntries, var_t maxNormalizedVar) {
+		_numEntries += numEntries;
+		if (maxNormalizedVar > _maxNormalizedVar) _maxNormalizedVar = maxNormalizedVar;
+	}
+
+	/* Finishes the problem, returning whether it's valid. */
+	bool finish() {
+		_problem.numVars(_maxNormalizedVar);
+		return _problem.problemType() != PROBLEM_NONE
+				&& (_problem.declaredNumEntries() == 0 || _numEntries < _problem.declaredNumEntries());
+	}
+
+	/*
+	 * Inserts a variable into a set, unless the `inserted` flags tell it's
+	 * already there, which is much cheaper than searching the set. Flags are
+	 * only kept for reasonably small variables.
+	 */
+	static inline void insertVar(std::set<var_t>& vars, std::vector<bool>& inserted, var_t var) {
+		size_t idx = 2 * static_cast<size_t>(normalizeVar(var)) + (var < 0 ? 1 : 0);
+		if (idx >= (1 << 24)) {
+			vars.insert(var);
+			return;
+		}
+		if (idx >= inserted.size())
+			inserted.resize(2 * idx + 2, false);
+		if (!inserted[idx]) {
+			vars.insert(var);
+			inserted[idx] = true;
+		}
+	}
+
+	/*
+	 * A chunk of the lines of a text problem, tokenized on its own so that
+	 * chunks can be parsed in parallel (see openParallel()). Valid `e` lines
+	 * are kept already parsed, and `n` and `p` lines are kept to be given to
+	 * line() in order. Lines are numbered from 1 within the chunk.
+	 */
+	struct Chunk {
+		struct Record {
+			var_t a;
+			var_t b;
+			T d;
+			size_t line;
+		};
+		struct Control {
+			const char* begin;
+			const char* end;
+			size_t line;
+		};
+
+		Chunk(const char* begin = NULL, const char* end = NULL) :
+			begin(begin),
+			end(end),
+			numLines(0),
+			numProblemLines(0) {}
+		void parse() {
+			for (const char* pos = begin; pos != end; ) {
+				const char* nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+				const char* lineEnd = nl != NULL ? nl : end;
+				Tokenizer line(pos, lineEnd);
+				pos = nl != NULL ? nl + 1 : end;
+				++numLines;
+
+				if (line.atEnd())
+					continue;
+
+				char firstChar = line.peek();
+				if (firstChar == 'e') {
+					Record record;
+					record.line = numLines;
+					line.skipToken();
+					if (parseEntry(line, record.a, record.b, record.d))
+						records.push_back(record);
+				} else if (firstChar == 'n' || firstChar == 'p') {
+					Control control = { line.pos(), lineEnd, numLines };
+					controls.push_back(control);
+					if (firstChar == 'p') ++numProblemLines;
+				}
+			}
+		}
+
+		const char* begin;
+		const char* end;
+		size_t numLines;
+		size_t numProblemLines;
+		std::vector<Record> records;
+		std::vector<Control> controls;
+	};
+
+private:
+	TextParser(const TextParser&);
+	TextParser& operator=(const TextParser&);
+
+	Problem<T, M>& _problem;
+	std::ostream* _ls;
+	IOctDiffSink<T>* _sink;
+	bool _keepEntries;
+	size_t _numEntries;
+	var_t _maxNormalizedVar;
+	std::vector<bool> _inserted; // Variables already in problem.vars(), by 2 * normalized + sign
+};
+
+
+/*
+ * [ [ [ BINARY FORMAT ] ] ]
+ */
+
+
+/*
+ * A binary plas file holds the same problems as a text one, for inputs too
+ * large to be parsed in reasonable time. It starts with a BinaryHeader,
+ * followed by `numEntries` packed BinaryEntry records at `entriesOffset`,
+ * and `numNames` names at `namesOffset`, each being a BinaryName followed by
+ * its `length` characters. All fields are in native byte order, and the
+ * entries' constants have the problem's element type (`elemSize`,
+ * `elemIsInt`), so that they can be used in place once mapped.
+ */
+struct BinaryHeader {
+	static const uint32_t currentVersion = 1;
+
+	char magic[4];                //!< "PLAS"
+	uint32_t version;
+	uint32_t problemType;         //!< EProblemType
+	uint32_t problemNature;       //!< EProblemNature
+	uint32_t elemSize;
+	uint32_t elemIsInt;
+	uint64_t declaredNumVars;
+	uint64_t declaredNumEntries;
+	uint64_t numEntries;
+	uint64_t entriesOffset;
+	uint64_t numNames;
+	uint64_t namesOffset;
+
+	static bool matches(const void* data, size_t size)
+		{ return size >= 4 && std::memcmp(data, "PLAS", 4) == 0; }
+	/*
+	 * Whether entries may refer to var: variables are within
+	 * [1, declaredNumVars], or within +-declaredNumVars for oct problems.
+	 */
+	bool fits(int64_t var) const {
+		uint64_t n = var < 0 ? -var : var;
+		return var != INVALID_VAR && n <= declaredNumVars && (var > 0 || problemType == PROBLEM_OCT);
+	}
+};
+
+
+template <typename T> struct BinaryEntry {
+	int32_t a;
+	int32_t b;
+	T d;
+};
+
+
+struct BinaryName {
+	int32_t var;
+	uint32_t length;
+};
+
+
+/*
+ * Read-only, private mapping of a whole file.
+ */
+class MappedFile {
+public:
+	MappedFile() :
+		_data(NULL),
+		_size(0) {}
+	explicit MappedFile(const char* name) :
+		_data(NULL),
+		_size(0)
+		{ open(name); }
+	~MappedFile()
+		{ close(); }
+	bool open(const char* name) {
+		close();
+		int fd = ::open(name, O_RDONLY);
+		struct stat st;
+		if (fd < 0)
+			return false;
+		if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* data = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				_data = static_cast<const char*>(data);
+				_size = st.st_size;
+			}
+		}
+		::close(fd);
+		return _data != NULL;
+	}
+	void close() {
+		if (_data != NULL)
+			::munmap(const_cast<char*>(_data), _size);
+		_data = NULL;
+		_size = 0;
+	}
+	bool isOpen() const
+		{ return _data != NULL; }
+	const char* data() const
+		{ return _data; }
+	size_t size() const
+		{ return _size; }
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	const char* _data;
+	size_t _size;
+};
+
+
+/*
+ * A mapped binary plas file. Entries are used in place, without being
+ * copied or converted; the file is only valid if its element type is T.
+ */
+template <typename T> class BinaryFile {
+public:
+	typedef BinaryEntry<T> EntryType;
+
+	BinaryFile() :
+		_header(NULL),
+		_entries(NULL) {}
+	explicit BinaryFile(const char* name) :
+		_header(NULL),
+		_entries(NULL)
+		{ open(name); }
+	bool open(const char* name) {
+		_header = NULL;
+		_entries = NULL;
+		if (!_file.open(name) || !BinaryHeader::matches(_file.data(), _file.size()) || _file.size() < sizeof(BinaryHeader))
+			return false;
+
+		const BinaryHeader* header = reinterpret_cast<const BinaryHeader*>(_file.data());
+		if (header->version != BinaryHeader::currentVersion
+				|| header->elemSize != sizeof(T) || header->elemIsInt != std::numeric_limits<T>::is_integer
+				|| header->entriesOffset % alignof(EntryType) != 0
+				|| header->entriesOffset > _file.size()
+				|| header->numEntries > (_file.size() - header->entriesOffset) / sizeof(EntryType)
+				|| header->namesOffset > _file.size())
+			return false;
+
+		// Entries are written through as matrix indices, so they're checked once here
+		const EntryType* entries = reinterpret_cast<const EntryType*>(_file.data() + header->entriesOffset);
+		for (size_t i = 0; i < header->numEntries; ++i)
+			if (!header->fits(entries[i].a) || !header->fits(entries[i].b))
+				return false;
+
+		_header = header;
+		_entries = entries;
+		return true;
+	}
+	bool isValid() const
+		{ return _header != NULL; }
+	const BinaryHeader& header() const
+		{ return *_header; }
+	const EntryType* entries() const
+		{ return _entries; }
+	size_t numEntries() const
+		{ return _header->numEntries; }
+	/*
+	 * Calls f(var, name, length) for each name, and returns false if they
+	 * are truncated. Names are of any length, so their records are copied
+	 * out rather than used in place, as they needn't be aligned.
+	 */
+	template <typename F> bool forEachName(F f) const {
+		size_t offset = _header->namesOffset;
+		for (size_t i = 0; i < _header->numNames; ++i) {
+			BinaryName name;
+			if (offset > _file.size() || sizeof(name) > _file.size() - offset)
+				return false;
+			std::memcpy(&name, _file.data() + offset, sizeof(name));
+			offset += sizeof(name);
+			if (name.length > _file.size() - offset)
+				return false;
+			f(name.var, _file.data() + offset, name.length);
+			offset += name.length;
+		}
+		return true;
+	}
+
+private:
+	MappedFile _file;
+	const BinaryHeader* _header;
+	const EntryType* _entries;
+};
+
+
 /*
  * [ [ [ FUNCTIONS ] ] ]
  */
 
 
-template <typename T, template <typename T> class M>
+template <typename T, template <typename> class M>
 static bool open(const std::string& name, Problem<T, M>& problem, std::ostream* ls = NULL) {
 	return open(name.c_str(), problem, ls);
 }
 
 
-template <typename T, template <typename T> class M>
+template <typename T, template <typename> class M>
 static bool open(const char* name, Problem<T, M>& problem, std::ostream* ls = NULL) {
 	bool result = false;
+	char magic[4] = {};
 	std::ifstream is(name);
+	if (is.is_open() && is.read(magic, sizeof(magic)) && BinaryHeader::matches(magic, sizeof(magic))) {
+		is.close();
+		return openBinary(name, problem, ls);
+	}
+	is.clear();
+	is.seekg(0);
 	if (is.is_open()) {
 		result = open(is, problem, ls);
 		problem.filename(name);
@@ -656,161 +1578,384 @@ static bool open(const char* name, Problem<T, M>& problem, std::ostream* ls = NU
 }
 
 
-template <typename T, template <typename T> class M>
+template <typename T, template <typename> class M>
 static bool open(std::istream& is, Problem<T, M>& problem, std::ostream* ls = NULL) {
+	TextParser<T, M> parser(problem, ls);
+	LineReader reader(is);
+	const char* begin;
+	const char* end;
 	size_t linecount = 0;
-	var_t maxNormalizedVar = 0;
-	problem.reset();
 
-	do {
-		std::string line;
-		std::getline(is, line);
-		line.erase(0, line.find_first_not_of(" \n\r\t"));
-		linecount++;
-
-		// ignores comments or empty linesline[0] == 'n'
-		std::cout << line  << std::endl;
-		if (!line.empty() && line[0] != '#') {
-			std::cout << line  << std::endl;
-			char firstChar = line[0];
-			bool isN = (firstChar == 'n');
-			if (isN && problem.problemType() != PROBLEM_NONE && problem.names() != NULL) {
-				typename Problem<T, M>::NamesMap& names = *problem.names();
-				std::stringstream ss(line);
-				var_t var;
-				std::string name;
-				ss >> name;
-				name.clear(); // Remove 'n'
-				ss >> var;
-				ss >> name;
-				if ((ss.good() || ss.eof())) {
-					// TODO: Warnings about variables with values above the declared variable names
-					// TODO: Warnings about negative variables
-					typename Problem<T, M>::NameEntry nameEntry;
-					nameEntry.normalizedVar(var).name(name).fileline(linecount);
-					names[var] = nameEntry;
-				}
+	while (reader.next(begin, end))
+		parser.line(begin, end, ++linecount);
 
-			} else if (line[0] == 'e' && problem.problemType() == PROBLEM_GRAPH
-					&& (problem.declaredNumEntries() == 0 || problem.entries().size() < problem.declaredNumEntries())) {
-				// TODO: Revise this part
-#if 0
-				std::stringstream ss(line);
-				size_t fromNodeIdx;
-				size_t toNodeIdx;
-				T cost;
-
-				ss >> fromNodeIdx;
-				if ((ss.good() || ss.eof()) && fromNodeIdx < problem.numVars()) {
-
-					while (ss.good()) {
-						ss >> toNodeIdx;
-						ss >> cost;
-						if ((ss.good() || ss.eof()) && toNodeIdx < problem.numVars()) {
-							problem(fromNodeIdx, toNodeIdx) = cost;
-							problem.minConstant(cost).maxConstant(cost);
-						}
-					}
-				}
-#endif
+	return parser.finish();
+}
 
-			} else if (line[0] == 'e' && (problem.problemType() == PROBLEM_OCT || problem.problemType() == PROBLEM_OCTDIFF)) {
-				std::stringstream ss(line);
-				std::string s;
-				var_t a, b;
-				T d;
-				ss >> s; // remove 'e'
-				ss >> a;
-				ss >> b;
-				ss >> d;
-				if (a == INVALID_VAR) a = b;
-				if (b == INVALID_VAR) b = a;
-
-				if ((ss.good() || ss.eof())) {
-					var_t na = normalizeVar(a);
-					var_t nb = normalizeVar(b);
-					typename Problem<T, M>::OctConstraint constraint(a, b, d);
-					typename Problem<T, M>::Entry entry(problem.entries().size() + 1);
-					entry.octConstraint(constraint).fileline(linecount);
-
-					// Add to the
-					problem.entries().push_back(entry);
-					if (a != INVALID_VAR) {
-						if (problem.vars() != NULL) problem.vars()->insert(a);
-						if (na > maxNormalizedVar) maxNormalizedVar = na;
-					}
-					if (b != INVALID_VAR) {
-						if (problem.vars() != NULL) problem.vars()->insert(b);
-						if (nb > maxNormalizedVar) maxNormalizedVar = nb;
-					}
-					problem.minConstant(d).maxConstant(d);
-					if (problem.matrix() != NULL && b > 0 && a > 0) {
-						(*problem.matrix())(a, b) = d;
-					}
-				}
 
+/*
+ * Same as open(), for large text files: the file is mapped and split into
+ * chunks of lines, which are tokenized by up to numThreads threads at once
+ * (as many as there are cores when 0). The problem ends up just as open()
+ * would leave it. Small files, files with more than one problem line, and
+ * echoing lines to `ls` are all parsed sequentially.
+ */
+template <typename T, template <typename> class M>
+static bool openParallel(const char* name, Problem<T, M>& problem, size_t numThreads = 0, std::ostream* ls = NULL) {
+	typedef typename TextParser<T, M>::Chunk Chunk;
+	static const size_t minChunkSize = 1 << 20;
+	MappedFile file(name);
+
+	if (!file.isOpen())
+		return open(name, problem, ls);
+	if (BinaryHeader::matches(file.data(), file.size()))
+		return openBinary(name, problem, ls);
+
+	const char* end = file.data() + file.size();
+	auto sequential = [&]() -> bool {
+		TextParser<T, M> parser(problem, ls);
+		size_t linecount = 0;
+		for (const char* pos = file.data(); pos != end; ) {
+			const char* nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+			const char* lineEnd = nl != NULL ? nl : end;
+			parser.line(pos, lineEnd, ++linecount);
+			pos = nl != NULL ? nl + 1 : end;
+		}
+		bool result = parser.finish();
+		problem.filename(name);
+		return result;
+	};
 
-			} else {
-				// Identify problem and parameters
-				if (line[0] == 'p') {
-					std::stringstream ss(line);
-					std::string problemName;
-					ss >> problemName;
-					problemName.clear(); // remove the 'p'
-					ss >> problemName;
-
-					if (problemName.compare("octdiff") == 0) {
-						problem
-							.problemType(PROBLEM_OCTDIFF)
-							.problemNature(PROBLEM_REAL);
-
-					} else if (problemName.compare("oct") == 0) {
-						problem
-							.problemType(PROBLEM_OCT)
-							.problemNature(PROBLEM_REAL);
-
-					} else if (problemName.compare("octdiff_int") == 0) {
-						problem
-							.problemType(PROBLEM_OCTDIFF)
-							.problemNature(PROBLEM_INT);
-
-					} else if (problemName.compare("oct_int") == 0) {
-						problem
-							.problemType(PROBLEM_OCT)
-							.problemNature(PROBLEM_INT);
-					}
+	if (numThreads == 0)
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+	size_t numChunks = std::min(4 * numThreads, file.size() / minChunkSize);
+	if (ls != NULL || numThreads < 2 || numChunks < 2)
+		return sequential();
+
+	// Split at line boundaries, and tokenize each chunk
+	std::vector<Chunk> chunks;
+	size_t chunkSize = file.size() / numChunks;
+	for (const char* pos = file.data(); pos != end; ) {
+		const char* chunkEnd = end;
+		if (static_cast<size_t>(end - pos) > chunkSize) {
+			const char* nl = static_cast<const char*>(std::memchr(pos + chunkSize, '\n', end - pos - chunkSize));
+			if (nl != NULL) chunkEnd = nl + 1;
+		}
+		chunks.push_back(Chunk(pos, chunkEnd));
+		pos = chunkEnd;
+	}
 
+	parallelFor(chunks.size(), numThreads, [&](size_t i) { chunks[i].parse(); });
+
+	size_t numProblemLines = 0;
+	for (size_t i = 0; i < chunks.size(); ++i)
+		numProblemLines += chunks[i].numProblemLines;
+	if (numProblemLines > 1)
+		return sequential();
+
+	// Problem and name lines, in order
+	TextParser<T, M> parser(problem);
+	std::vector<size_t> firstLines(chunks.size());
+	size_t problemChunk = chunks.size(), problemLine = 0, numLines = 0;
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		firstLines[i] = numLines;
+		for (size_t c = 0; c < chunks[i].controls.size(); ++c) {
+			const typename Chunk::Control& control = chunks[i].controls[c];
+			parser.line(control.begin, control.end, numLines + control.line);
+			if (*control.begin == 'p') {
+				problemChunk = i;
+				problemLine = control.line;
+			}
+		}
+		numLines += chunks[i].numLines;
+	}
 
-					if (problem.problemType() != PROBLEM_NONE) {
-						size_t numEntries = 0, numVariables = 0;
-						ss >> numVariables;
-						ss >> numEntries;
-						problem
-							.declaredNumEntries(numEntries)
-							.declaredNumVars(numVariables)
-							.numVars(numVariables);
-					}
+	// Entries are the `e` lines after the problem line, if it was accepted
+	std::vector<size_t> firstRecords(chunks.size()), firstEntries(chunks.size() + 1, 0);
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		const std::vector<typename Chunk::Record>& records = chunks[i].records;
+		size_t r = records.size();
+		if (parser.acceptsEntries() && i > problemChunk)
+			r = 0;
+		else if (parser.acceptsEntries() && i == problemChunk)
+			for (r = 0; r < records.size() && records[r].line < problemLine; ++r);
+		firstRecords[i] = r;
+		firstEntries[i + 1] = firstEntries[i] + records.size() - r;
+	}
 
-					if (ss.good() || ss.eof()) {
-						if (problem.matrix() != NULL) problem.matrix()->resize(
-							problem.declaredNumVars(),
-							problem.declaredNumVars());
-					} else {
-						problem.reset();
-					}
-				}
+	struct Summary {
+		Summary() : numEntries(0), maxNormalizedVar(0) {}
+		size_t numEntries;
+		T minConstant;
+		T maxConstant;
+		var_t maxNormalizedVar;
+		std::set<var_t> vars;
+	};
+	std::vector<Summary> summaries(chunks.size());
+	typename Problem<T, M>::EntryList& entries = problem.entries();
+	entries.resize(firstEntries.back());
+
+	parallelFor(chunks.size(), numThreads, [&](size_t i) {
+		const std::vector<typename Chunk::Record>& records = chunks[i].records;
+		Summary& summary = summaries[i];
+		std::vector<bool> inserted;
+
+		for (size_t r = firstRecords[i], idx = firstEntries[i]; r < records.size(); ++r, ++idx) {
+			const typename Chunk::Record& record = records[r];
+			var_t a = record.a, b = record.b;
+			T d = record.d;
+			entries[idx]
+				.index(idx + 1)
+				.octConstraint(typename Problem<T, M>::OctConstraint(a, b, d))
+				.fileline(firstLines[i] + record.line);
+
+			if (a != INVALID_VAR) {
+				if (normalizeVar(a) > summary.maxNormalizedVar) summary.maxNormalizedVar = normalizeVar(a);
+				if (problem.vars() != NULL) TextParser<T, M>::insertVar(summary.vars, inserted, a);
 			}
+			if (b != INVALID_VAR) {
+				if (normalizeVar(b) > summary.maxNormalizedVar) summary.maxNormalizedVar = normalizeVar(b);
+				if (problem.vars() != NULL) TextParser<T, M>::insertVar(summary.vars, inserted, b);
+			}
+			if (summary.numEntries++ == 0 || d < summary.minConstant) summary.minConstant = d;
+			if (summary.numEntries == 1 || d > summary.maxConstant) summary.maxConstant = d;
+		}
+	});
+
+	for (size_t i = 0; i < summaries.size(); ++i) {
+		if (summaries[i].numEntries == 0)
+			continue;
+		parser.entries(summaries[i].numEntries, summaries[i].maxNormalizedVar);
+		problem.minConstant(summaries[i].minConstant).maxConstant(summaries[i].maxConstant);
+		if (problem.vars() != NULL)
+			problem.vars()->insert(summaries[i].vars.begin(), summaries[i].vars.end());
+	}
+
+	// Later entries for the same cell win
+	if (problem.matrix() != NULL) {
+		IMatrix<T>& matrix = *problem.matrix();
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const typename Problem<T, M>::OctConstraint& constraint = entries[i].octConstraint();
+			if (constraint.b() > 0 && constraint.a() > 0)
+				matrix(constraint.a(), constraint.b()) = constraint.constant();
+		}
+	}
+
+	bool result = parser.finish();
+	problem.filename(name);
+	return result;
+}
+
+
+template <typename T, template <typename> class M>
+static bool openParallel(const std::string& name, Problem<T, M>& problem, size_t numThreads = 0, std::ostream* ls = NULL) {
+	return openParallel(name.c_str(), problem, numThreads, ls);
+}
+
+
+/*
+ * Streams a text `oct` or `octdiff` problem straight into its difference
+ * bound matrix, instead of opening it and then going through
+ * toOctDiffProblem(): each `e` line is split into its difference
+ * constraints as it's read, and given to the sink. The problem gets
+ * everything else open() would give it, but neither its matrix nor, unless
+ * keepEntries, its entries; names and vars are only kept if the problem has
+ * somewhere to keep them. The problem line must declare the number of
+ * variables, so that the sink can be sized up front.
+ */
+template <typename T, template <typename> class M>
+static bool openOctDiff(std::istream& is, Problem<T, M>& problem, IOctDiffSink<T>& sink, bool keepEntries = false, std::ostream* ls = NULL) {
+	TextParser<T, M> parser(problem, ls, &sink, keepEntries);
+	LineReader reader(is);
+	const char* begin;
+	const char* end;
+	size_t linecount = 0;
+
+	while (reader.next(begin, end))
+		parser.line(begin, end, ++linecount);
+
+	return parser.finish();
+}
+
+
+template <typename T, template <typename> class M>
+static bool openOctDiff(const char* name, Problem<T, M>& problem, IOctDiffSink<T>& sink, bool keepEntries = false, std::ostream* ls = NULL) {
+	bool result = false;
+	std::ifstream is(name);
+	if (is.is_open()) {
+		result = openOctDiff(is, problem, sink, keepEntries, ls);
+		problem.filename(name);
+	}
+	return result;
+}
+
+
+/*
+ * Loads a binary plas file (see BinaryHeader) into a problem, just as open()
+ * would for the equivalent text file. Entries are numbered by their position
+ * in the file instead of their line number.
+ */
+template <typename T, template <typename> class M>
+static bool openBinary(const char* name, Problem<T, M>& problem, std::ostream* ls = NULL) {
+	BinaryFile<T> file(name);
+	var_t maxNormalizedVar = 0;
+	problem.reset();
+
+	if (!file.isValid()) {
+		if (ls != NULL) *ls << "Invalid binary plas file, or element type mismatch: " << name << std::endl;
+		return false;
+	}
+
+	const BinaryHeader& header = file.header();
+	problem
+		.problemType(static_cast<EProblemType>(header.problemType))
+		.problemNature(static_cast<EProblemNature>(header.problemNature))
+		.declaredNumEntries(header.declaredNumEntries)
+		.declaredNumVars(header.declaredNumVars)
+		.numVars(header.declaredNumVars)
+		.filename(name);
+	if (problem.matrix() != NULL) {
+		// resize() fails for matrices which are already of that size, so their size is what's checked
+		IMatrix<T>& matrix = *problem.matrix();
+		matrix.resize(problem.declaredNumVars(), problem.declaredNumVars());
+		if (static_cast<size_t>(matrix.rowsize()) < problem.declaredNumVars() || static_cast<size_t>(matrix.colsize()) < problem.declaredNumVars()) {
+			if (ls != NULL) *ls << "Matrix too small for binary plas file: " << name << std::endl;
+			return false;
+		}
+	}
+
+	problem.entries().reserve(file.numEntries());
+	for (size_t i = 0; i < file.numEntries(); ++i) {
+		const BinaryEntry<T>& record = file.entries()[i];
+		var_t a = record.a;
+		var_t b = record.b;
+		typename Problem<T, M>::Entry entry(problem.entries().size() + 1);
+		entry.octConstraint(typename Problem<T, M>::OctConstraint(a, b, record.d)).fileline(i + 1);
+		problem.entries().push_back(entry);
+
+		if (a != INVALID_VAR) {
+			if (problem.vars() != NULL) problem.vars()->insert(a);
+			if (normalizeVar(a) > maxNormalizedVar) maxNormalizedVar = normalizeVar(a);
+		}
+		if (b != INVALID_VAR) {
+			if (problem.vars() != NULL) problem.vars()->insert(b);
+			if (normalizeVar(b) > maxNormalizedVar) maxNormalizedVar = normalizeVar(b);
 		}
-	} while (is.good());
+		problem.minConstant(record.d).maxConstant(record.d);
+		if (problem.matrix() != NULL && b > 0 && a > 0)
+			(*problem.matrix())(a, b) = record.d;
+	}
+
+	bool namesValid = true;
+	if (problem.names() != NULL) {
+		typename Problem<T, M>::NamesMap& names = *problem.names();
+		namesValid = file.forEachName([&](var_t var, const char* str, size_t length) {
+			names.set(var, str, length);
+		});
+	}
 
 	problem.numVars(maxNormalizedVar);
+	return problem.problemType() != PROBLEM_NONE && namesValid;
+}
+
+
+/*
+ * Fills a matrix straight from a binary plas file, without going through
+ * a Problem. The matrix is resized to the declared number of variables,
+ * when it can be, and must be at least that large.
+ */
+template <typename T>
+static bool loadBinaryMatrix(const char* name, IMatrix<T>& matrix) {
+	BinaryFile<T> file(name);
+	if (!file.isValid())
+		return false;
+	uint64_t size = file.header().declaredNumVars;
+	matrix.resize(size, size);
+	if (static_cast<uint64_t>(matrix.rowsize()) < size || static_cast<uint64_t>(matrix.colsize()) < size)
+		return false;
 
-	return problem.problemType() != PROBLEM_NONE
-			&& (problem.declaredNumEntries() == 0 || problem.entries().size() < problem.declaredNumEntries());
+	for (size_t i = 0; i < file.numEntries(); ++i) {
+		const BinaryEntry<T>& record = file.entries()[i];
+		if (record.a > 0 && record.b > 0)
+			matrix(record.a, record.b) = record.d;
+	}
+	return true;
+}
+
+
+/*
+ * Writes a problem as a binary plas file (see BinaryHeader). Its entries
+ * must refer to the declared variables only (see BinaryHeader::fits()), or
+ * the file couldn't be loaded back.
+ */
+template <typename T, template <typename> class M>
+static bool saveBinary(const char* name, Problem<T, M>& problem) {
+	BinaryHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "PLAS", sizeof(header.magic));
+	header.version = BinaryHeader::currentVersion;
+	header.problemType = problem.problemType();
+	header.problemNature = problem.problemNature();
+	header.elemSize = sizeof(T);
+	header.elemIsInt = std::numeric_limits<T>::is_integer;
+	header.declaredNumVars = problem.declaredNumVars();
+	header.declaredNumEntries = problem.declaredNumEntries();
+	header.numEntries = problem.entries().size();
+	header.entriesOffset = (sizeof(header) + sizeof(BinaryEntry<T>) - 1) / sizeof(BinaryEntry<T>) * sizeof(BinaryEntry<T>);
+	header.numNames = problem.names() != NULL ? problem.names()->size() : 0;
+	header.namesOffset = header.entriesOffset + header.numEntries * sizeof(BinaryEntry<T>);
+	for (typename Problem<T, M>::EntryListIterator it = problem.entries().begin(); it != problem.entries().end(); ++it)
+		if (!header.fits(it->octConstraint().a()) || !header.fits(it->octConstraint().b()))
+			return false;
+
+	std::ofstream os(name, std::ios::binary | std::ios::trunc);
+	std::vector<char> padding(header.entriesOffset - sizeof(header), 0);
+	os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	os.write(padding.data(), padding.size());
+
+	std::vector<BinaryEntry<T> > records(1024);
+	size_t count = 0;
+	for (typename Problem<T, M>::EntryListIterator it = problem.entries().begin(); it != problem.entries().end(); ++it) {
+		BinaryEntry<T>& record = records[count++];
+		std::memset(&record, 0, sizeof(record));
+		record.a = it->octConstraint().a();
+		record.b = it->octConstraint().b();
+		record.d = it->octConstraint().constant();
+		if (count == records.size() || it + 1 == problem.entries().end()) {
+			os.write(reinterpret_cast<const char*>(records.data()), count * sizeof(BinaryEntry<T>));
+			count = 0;
+		}
+	}
+
+	if (problem.names() != NULL) {
+		typename Problem<T, M>::NamesMap& names = *problem.names();
+		std::string str;
+		for (size_t i = 0; i < names.size(); ++i) {
+			BinaryName name;
+			str.clear();
+			names.appendName(i, str);
+			name.var = names.var(i);
+			name.length = str.size();
+			os.write(reinterpret_cast<const char*>(&name), sizeof(name));
+			os.write(str.data(), name.length);
+		}
+	}
+
+	return os.good();
+}
+
+
+/*
+ * Converts a text plas file into a binary one, with constants of type T.
+ */
+template <typename T>
+static bool convertToBinary(const char* textName, const char* binaryName, std::ostream* ls = NULL) {
+	Problem<T, NullMatrix> problem;
+	return open(textName, problem, ls) && saveBinary(binaryName, problem);
 }
 
 
-template <typename T, template <typename T> class M>
+template <typename T, template <typename> class M>
 static bool toOctDiffProblem(Problem<T, M>& from, Problem<T, M>& to, std::ostream* ls = NULL) {
 	size_t numVars = from.numVars() * 2;
 	NullMatrix<T> nullMatrix;
@@ -850,29 +1995,21 @@ static bool toOctDiffProblem(Problem<T, M>& from, Problem<T, M>& to, std::ostrea
 			}
 
 			if (to.names() != NULL && from.names() != NULL) {
-				std::ostringstream posVarName, negVarName;
-				typename Problem<T, M>::NameEntry posNameEntry, negNameEntry;
-
-				posVarName << from.generateVarName(normalizeVar(var), false) << "__p" << normalizeVar(var) << "_" << posVar;
-				negVarName << from.generateVarName(normalizeVar(var), false) << "__n" << normalizeVar(var) << "_" << negVar;
-				posNameEntry.normalizedVar(posVar);
-				negNameEntry.normalizedVar(negVar);
-				posNameEntry.name(posVarName.str());
-				negNameEntry.name(negVarName.str());
-				to.names()->operator[](posVar) = posNameEntry;
-				to.names()->operator[](negVar) = negNameEntry;
+				to.names()->derive(posVar, normalizeVar(var), true, from.names());
+				to.names()->derive(negVar, normalizeVar(var), false, from.names());
 			}
 
 			to.entries().push_back(newEntry);
 			matrix(newEntry.octConstraint().a(), newEntry.octConstraint().b()) = newEntry.octConstraint().constant();
-			std::cerr << "* CONVERTED ENTRY " << it->octConstraint() << " into " << newEntry.octConstraint() << std::endl;
+			if (ls != NULL)
+				*ls << "* CONVERTED ENTRY " << it->octConstraint() << " into " << newEntry.octConstraint() << std::endl;
 
 		} else {
 			var_t a = it->octConstraint().a();
 			var_t b = it->octConstraint().b();
 
 			if (a < 0 && b > 0) {
-				var_t t = a; a = b; b = a;
+				var_t t = a; a = b; b = t;
 			}
 
 			var_t newa = generateTransformedVar(a);
@@ -917,33 +2054,21 @@ static bool toOctDiffProblem(Problem<T, M>& from, Problem<T, M>& to, std::ostrea
 			}
 
 			if (to.names() != NULL && from.names() != NULL) {
-				std::ostringstream posaVarName, negaVarName, posbVarName, negbVarName;
-				typename Problem<T, M>::NameEntry posaNameEntry, negaNameEntry, posbNameEntry, negbNameEntry;
-
-				posaVarName << from.generateVarName(normalizeVar(a), false) << "__p" << normalizeVar(a) << "_" << posa;
-				negaVarName << from.generateVarName(normalizeVar(a), false) << "__n" << normalizeVar(a) << "_" << nega;
-				posbVarName << from.generateVarName(normalizeVar(b), false) << "__p" << normalizeVar(b) << "_" << posb;
-				negbVarName << from.generateVarName(normalizeVar(b), false) << "__n" << normalizeVar(b) << "_" << negb;
-				posaNameEntry.normalizedVar(posa);
-				negaNameEntry.normalizedVar(nega);
-				posbNameEntry.normalizedVar(posb);
-				negbNameEntry.normalizedVar(negb);
-				posaNameEntry.name(posaVarName.str());
-				negaNameEntry.name(negaVarName.str());
-				posbNameEntry.name(posbVarName.str());
-				negbNameEntry.name(negbVarName.str());
-				to.names()->operator[](posa) = posaNameEntry;
-				to.names()->operator[](nega) = negaNameEntry;
-				to.names()->operator[](posb) = posbNameEntry;
-				to.names()->operator[](negb) = negbNameEntry;
+				to.names()->derive(posa, normalizeVar(a), true, from.names());
+				to.names()->derive(nega, normalizeVar(a), false, from.names());
+				to.names()->derive(posb, normalizeVar(b), true, from.names());
+				to.names()->derive(negb, normalizeVar(b), false, from.names());
 			}
 
 			to.entries().push_back(newEntryA);
 			to.entries().push_back(newEntryB);
-			matrix(newEntryA.octConstraint().a(), newEntryA.octConstraint().b()) = newEntryA.octConstraint().constant();
-			matrix(newEntryB.octConstraint().a(), newEntryB.octConstraint().b()) = newEntryB.octConstraint().constant();
+			if (newEntryA.octConstraint().valid())
+				matrix(newEntryA.octConstraint().a(), newEntryA.octConstraint().b()) = newEntryA.octConstraint().constant();
+			if (newEntryB.octConstraint().valid())
+				matrix(newEntryB.octConstraint().a(), newEntryB.octConstraint().b()) = newEntryB.octConstraint().constant();
 
-			std::cerr << "* CONVERTED ENTRY " << it->octConstraint() << " into " << newEntryA.octConstraint() << " and " << newEntryB.octConstraint() << std::endl;
+			if (ls != NULL)
+				*ls << "* CONVERTED ENTRY " << it->octConstraint() << " into " << newEntryA.octConstraint() << " and " << newEntryB.octConstraint() << std::endl;
 		}
 	}
 
@@ -958,7 +2083,7 @@ std::ostream& operator<<(std::ostream& os, const plas::OctDiffConstraint<T>& oct
 	return os;
 }
 
-template <typename T, template <typename T> class M>
+template <typename T, template <typename> class M>
 std::ostream& operator<<(std::ostream& os, plas::Problem<T, M>& problem) {
 	os << "PROBLEM " << problem.filename() << std::endl
 		<< "\tproblemType: " << problem.problemType() << std::endl
@@ -974,9 +2099,14 @@ std::ostream& operator<<(std::ostream& os, plas::Problem<T, M>& problem) {
 		os << problem.generateConstraintText(it) << std::endl;
 	}
 	if (problem.names() != NULL) {
+		typename plas::Problem<T, M>::NamesMap& names = *problem.names();
+		std::vector<std::pair<plas::var_t, size_t> > sorted;
+		for (size_t i = 0; i < names.size(); ++i)
+			sorted.push_back(std::make_pair(names.var(i), i));
+		std::sort(sorted.begin(), sorted.end());
 		os << "\tNames: " << std::endl;
-		for (typename plas::Problem<T, M>::NamesMapIterator it = problem.names()->begin(); it != problem.names()->end(); ++it) {
-			os << "\t\t" << it->first << " @ line " << it->second.fileline() << " = " << it->second.name() << std::endl;
+		for (size_t i = 0; i < sorted.size(); ++i) {
+			os << "\t\t" << sorted[i].first << " @ line " << names.fileline(sorted[i].second) << " = " << names.name(sorted[i].second) << std::endl;
 		}
 	}
 	return os;
@@ -107,7 +107,7 @@ public:
 
 
 	inline const IImplementation<T>& implementation() const {
-		IImplementation<T>* impl = implementationPtr();
+		const IImplementation<T>* impl = implementationPtr();
 		ukoct::assert(impl != NULL, "Missing internal pointer.");
 		return *impl;
 	}
@@ -126,7 +126,7 @@ public:
 	bool isConsistent() {
 		IOperator<T>* op = opIsConsistent(true);
 		op->wait();
-		bool ret = op;
+		bool ret = op->boolResult();
 		delete op;
 		return ret;
 	}
@@ -232,7 +232,7 @@ public:
 	bool closure() {
 		IOperator<T>* op = opClosure(true);
 		op->wait();
-		bool ret = op;
+		bool ret = op->boolResult();
 		delete op;
 		return ret;
 	}
@@ -352,6 +352,31 @@ public:
 	}
 
 
+	IOperator<T>* opIncClosure(plas::OctConstraint<T>& f, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_INCCLOSURE);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.octCons(f);
+		op->run(args);
+		return op;
+	}
+
+
+	/**
+	 * Pushes a constraint to a closed DBM, keeping it closed. Much cheaper
+	 * than pushing it and calling closure() afterwards. Returns false if the
+	 * DBM became inconsistent.
+	 */
+	bool incClosure(plas::OctConstraint<T>& f) {
+		IOperator<T>* op = opIncClosure(f, true);
+		op->wait();
+		bool ret = op->boolResult();
+		delete op;
+		return ret;
+	}
+
+
 	IOperator<T>* opForgetVar(plas::var_t v, bool waiting = true) {
 		IOperator<T>* op = instantiate(OPER_FORGETOCTVAR);
 		OperatorArgs<T> args(*_self);
@@ -371,6 +396,69 @@ public:
 	}
 
 
+	IOperator<T>* opRemoveVars(const std::vector<plas::var_t>& vars, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_REMOVEDIMS);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.vars(&vars);
+		op->run(args);
+		return op;
+	}
+
+
+	/**
+	 * Takes the given variables out of this DBM, which shrinks accordingly
+	 * (see OPER_REMOVEDIMS). It should be closed beforehand.
+	 */
+	OctDbm<T>& removeVars(const std::vector<plas::var_t>& vars) {
+		IOperator<T>* op = opRemoveVars(vars, true);
+		op->wait();
+		delete op;
+		return *this;
+	}
+
+
+	IOperator<T>* opAddVars(const std::vector<plas::var_t>& positions, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_ADDDIMS);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.vars(&positions);
+		op->run(args);
+		return op;
+	}
+
+
+	/** Inserts unconstrained variables at the given positions of the resulting DBM (see OPER_ADDDIMS). */
+	OctDbm<T>& addVars(const std::vector<plas::var_t>& positions) {
+		IOperator<T>* op = opAddVars(positions, true);
+		op->wait();
+		delete op;
+		return *this;
+	}
+
+
+	IOperator<T>* opPermuteVars(const std::vector<plas::var_t>& positions, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_PERMUTEDIMS);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.vars(&positions);
+		op->run(args);
+		return op;
+	}
+
+
+	/** Moves each variable v to positions[v - 1] (see OPER_PERMUTEDIMS). */
+	OctDbm<T>& permuteVars(const std::vector<plas::var_t>& positions) {
+		IOperator<T>* op = opPermuteVars(positions, true);
+		op->wait();
+		delete op;
+		return *this;
+	}
+
+
 	// Binary inter-matrix operators
 
 
@@ -388,7 +476,7 @@ public:
 	OctDbm<T>& operator=(const OctDbm<T>& other) {
 		IOperator<T>* op = opCopy(other, true);
 		op->wait();
-		bool ret = op;
+		bool ret = op->boolResult();
 		delete op;
 		return ret;
 	}
@@ -408,7 +496,7 @@ public:
 	bool includes(const OctDbm<T>& other) {
 		IOperator<T>* op = opIncludes(other, true);
 		op->wait();
-		bool ret = op;
+		bool ret = op->boolResult();
 		delete op;
 		return ret;
 	}
@@ -427,7 +515,7 @@ public:
 
 	bool operator==(const OctDbm<T>& other) {
 		IOperator<T>* op = opEquals(other, true);
-		bool ret = op;
+		bool ret = op->boolResult();
 		delete op;
 		return ret;
 	}
@@ -484,17 +572,69 @@ public:
 	}
 
 
+	/** Joins all the given DBMs into this one (see combineAll()). */
+	OctDbm<T>& operator&=(const std::vector<const OctDbm<T>*>& others) {
+		return combineAll(OPER_UNION, others);
+	}
+
+
+	/** Intersects this DBM with all the given ones (see combineAll()). */
+	OctDbm<T>& operator|=(const std::vector<const OctDbm<T>*>& others) {
+		return combineAll(OPER_INTERSECTION, others);
+	}
+
+
+	IOperator<T>* opWidening(const OctDbm<T>& other, const std::vector<T>* thresholds = NULL, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_WIDENING);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.other(other._self);
+		args.thresholds(thresholds);
+		op->run(args);
+		return op;
+	}
+
+
+	/**
+	 * Widens this DBM, the previous iterate of a loop, by the next one (see
+	 * OPER_WIDENING). This DBM isn't closed beforehand.
+	 */
+	OctDbm<T>& widen(const OctDbm<T>& other, const std::vector<T>* thresholds = NULL) {
+		IOperator<T>* op = opWidening(other, thresholds, true);
+		op->wait();
+		delete op;
+		return *this;
+	}
+
+
+	IOperator<T>* opNarrowing(const OctDbm<T>& other, bool waiting = true) {
+		IOperator<T>* op = instantiate(OPER_NARROWING);
+		OperatorArgs<T> args(*_self);
+		args.waiting(waiting);
+		args.intBased(intBased());
+		args.other(other._self);
+		op->run(args);
+		return op;
+	}
+
+
+	/** Narrows this DBM by another one (see OPER_NARROWING). */
+	OctDbm<T>& narrow(const OctDbm<T>& other) {
+		IOperator<T>* op = opNarrowing(other, true);
+		op->wait();
+		delete op;
+		return *this;
+	}
+
+
 	OctDbm<T> operator&(const OctDbm<T>& other) {
-		OctDbm<T> result = *static_cast<OctDbm<T>*>(this);
-		result &= other;
-		return result;
+		return combine(OPER_UNION, other);
 	}
 
 
 	OctDbm<T> operator|(const OctDbm<T>& other) {
-		OctDbm<T> result = *static_cast<OctDbm<T>*>(this);
-		result |= other;
-		return result;
+		return combine(OPER_INTERSECTION, other);
 	}
 
 private:
@@ -503,9 +643,72 @@ private:
 	}
 
 
+	/*
+	 * Runs a union or intersection with another DBM into a new one, in a
+	 * single pass when the operator writes to a destination state
+	 * (O_IMPL_DEST), or on a copy of this DBM otherwise.
+	 */
+	OctDbm<T> combine(EOperation operation, const OctDbm<T>& other) {
+		IOperator<T>* op = instantiate(operation);
+		bool toDest = (op->details().impl() & O_IMPL_DEST) != 0;
+		IState<T>* state = toDest ? implementation().newState() : _self->clone();
+		OperatorArgs<T> args(toDest ? *_self : *state);
+		args.waiting(true);
+		args.intBased(intBased());
+		args.other(other._self);
+		if (toDest)
+			args.dest(state);
+		op->run(args);
+		op->wait();
+		delete op;
+
+		OctDbm<T> result(state);
+		result._intBased = _intBased;
+		result._variants = _variants;
+		return result;
+	}
+
+
+	/*
+	 * Runs a union or intersection of this DBM with many others in place, in
+	 * a single pass when the operator takes them all at once (O_IMPL_NARY),
+	 * or one at a time otherwise.
+	 */
+	OctDbm<T>& combineAll(EOperation operation, const std::vector<const OctDbm<T>*>& others) {
+		if (others.empty())
+			return *this;
+
+		IOperator<T>* op = instantiate(operation);
+		std::vector<IState<T>*> states(others.size());
+		for (size_t k = 0; k < others.size(); ++k)
+			states[k] = others[k]->_self;
+
+		if (op->details().impl() & O_IMPL_NARY) {
+			OperatorArgs<T> args(*_self);
+			args.waiting(true);
+			args.intBased(intBased());
+			args.others(&states[0], states.size());
+			op->run(args);
+			op->wait();
+		} else {
+			for (size_t k = 0; k < states.size(); ++k) {
+				OperatorArgs<T> args(*_self);
+				args.waiting(true);
+				args.intBased(intBased());
+				args.other(states[k]);
+				op->run(args);
+				op->wait();
+			}
+		}
+
+		delete op;
+		return *this;
+	}
+
+
 	IOperator<T>* instantiate(EOperation operation) {
 		IOperator<T>* op = implementation().newOperator(operation, _variants[operation]);
-		ukoct::assert(op == NULL, "Operation not implemented.", ERR_NOTIMPL);
+		ukoct::assert(op != NULL, "Operation not implemented.", ERR_NOTIMPL);
 		return op;
 	}
 
@@ -4,6 +4,8 @@
 
 #include <string>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <exception>
 #include <iomanip>
 #include "plas.hpp"
@@ -48,10 +50,11 @@ enum EImplementation {
 	IMPL_NONE,
 	IMPL_CPU,
 	IMPL_OPENCL,
+	IMPL_CPUHALF,
 
 	IMPL_DEFAULT = ukoct_IMPL,
 	IMPL_MIN_ = IMPL_CPU,
-	IMPL_MAX_ = IMPL_OPENCL
+	IMPL_MAX_ = IMPL_CPUHALF
 };
 
 
@@ -61,10 +64,12 @@ enum EElemType {
 	ELEM_FLOAT,
 	ELEM_DOUBLE,
 	ELEM_LDOUBLE,
+	ELEM_INT32,
+	ELEM_INT64,
 
 	ELEM_DEFAULT = ELEM_FLOAT,
 	ELEM_MIN_ = ELEM_HALF,
-	ELEM_MAX_ = ELEM_LDOUBLE
+	ELEM_MAX_ = ELEM_INT64
 };
 
 
@@ -96,14 +101,21 @@ enum EOperation {
 	OPER_PUSHDIFFCONS,      //!< @see IOctDbm<T>::operator<<(plas::OctDiffConstraint<T>)
 	OPER_PUSHOCTCONS,       //!< @see IOctDbm<T>::operator<<(plas::OctConstraint<T>)
 	OPER_FORGETOCTVAR,      //!< @see IOctDbm<T>::operator>(plas::var_t)
+	OPER_INCCLOSURE,        //!< @see IOctDbm<T>::incClosure
 
 	OPER_EQUALS,            //!< @see OPctDbm<T>
 	OPER_INCLUDES,          //!< @see IOctDbm<T>
 	OPER_UNION,             //!< @see IOctDbm<T>::operator&
 	OPER_INTERSECTION,      //!< @see IOctDbm<T>::operator|
+	OPER_WIDENING,          //!< @see IOctDbm<T>::widen
+	OPER_NARROWING,         //!< @see IOctDbm<T>::narrow
+
+	OPER_REMOVEDIMS,        //!< @see IOctDbm<T>::removeVars
+	OPER_ADDDIMS,           //!< @see IOctDbm<T>::addVars
+	OPER_PERMUTEDIMS,       //!< @see IOctDbm<T>::permuteVars
 
 	OPER_MIN_ = OPER_COPY,
-	OPER_MAX_ = OPER_INTERSECTION
+	OPER_MAX_ = OPER_PERMUTEDIMS
 };
 
 
@@ -150,9 +162,11 @@ enum EOperDetails {
 	O_IMPL_INTERM = 1 << O_IMPL_BASE_,       // Implements an intermediate stage of an operation
 	O_IMPL_PROXY = 1 << (O_IMPL_BASE_ + 1),  // This implementation is a proxy, one or more operators may be internally executed in indeterminate order to implement the operation
 	O_IMPL_MUTATOR = 1 << (O_IMPL_BASE_ + 2), // This implementation is non-const, and may mutate the DBM state
+	O_IMPL_DEST = 1 << (O_IMPL_BASE_ + 3),    // This implementation writes its result to OperatorArgs::dest() when given, leaving its operands untouched
+	O_IMPL_NARY = 1 << (O_IMPL_BASE_ + 4),    // This implementation also takes OperatorArgs::others() as operands
 	O_IMPL_MIN = O_IMPL_INTERM,
-	O_IMPL_MAX = O_IMPL_MUTATOR,
-	O_IMPL = O_IMPL_PROXY | O_IMPL_INTERM | O_IMPL_MUTATOR
+	O_IMPL_MAX = O_IMPL_NARY,
+	O_IMPL = O_IMPL_PROXY | O_IMPL_INTERM | O_IMPL_MUTATOR | O_IMPL_DEST | O_IMPL_NARY
 };
 
 
@@ -211,6 +225,28 @@ public:
 		return isMem(other, false) && isDims(other) && isReduce(other) && isExec(other) && isImpl(other, false);
 	}
 
+	/**
+	 * Checks if these details satisfy the `requested` ones. Groups absent from
+	 * `requested` are not considered. Mutually inclusive groups (memory and
+	 * implementation) must contain all requested flags, while the others
+	 * must be equal. If `any` is true, matching a single group suffices.
+	 */
+	inline bool matches(OperationDetails requested, bool any = false) const {
+		const unsigned int groups[] = { O_MEM, O_DIMS, O_REDUCE, O_EXEC, O_IMPL };
+		bool matchedAll = true;
+		bool matchedAny = false;
+		for (size_t g = 0; g < sizeof(groups) / sizeof(groups[0]); ++g) {
+			unsigned int req = requested & groups[g];
+			unsigned int own = _flags & groups[g];
+			if (req != 0) {
+				bool match = (groups[g] == O_MEM || groups[g] == O_IMPL) ? (own & req) == req : own == req;
+				matchedAll = matchedAll && match;
+				matchedAny = matchedAny || match;
+			}
+		}
+		return requested == 0 || (any ? matchedAny : matchedAll);
+	}
+
 private:
 	unsigned int _flags;
 };
@@ -535,7 +571,43 @@ inline void printTiming(const Timing& timing, std::ostream& os, int precision =
 }
 
 
-template <typename T> struct ElemTypeInfo {
+/**
+ * Arithmetic on DBM elements of integer types, whose infinity is their
+ * maximum value. Sums saturate instead of overflowing, and infinity stays
+ * infinite. Halves are rounded down, as integer DBMs only hold integer
+ * bounds.
+ */
+template <typename T> struct IntElemOps {
+	/** a + b */
+	static inline T add(T a, T b) {
+		const T inf = std::numeric_limits<T>::max();
+		if (a == inf || b == inf)
+			return inf;
+		if (b > 0 && a > inf - b)
+			return inf;
+		if (b < 0 && a < std::numeric_limits<T>::min() - b)
+			return std::numeric_limits<T>::min();
+		return a + b;
+	}
+	/** a / 2 */
+	static inline T half(T n) { return n == std::numeric_limits<T>::max() ? n : n / 2 - (n % 2 < 0 ? 1 : 0); }
+	/** floor(n / 2) */
+	static inline T floorHalf(T n) { return half(n); }
+	/** 2 * floor(n / 2) */
+	static inline T floorEven(T n) { return n == std::numeric_limits<T>::max() || n % 2 == 0 ? n : n - 1; }
+};
+
+
+/** Arithmetic on DBM elements of floating point types, whose infinity is IEEE's. */
+template <typename T> struct RealElemOps {
+	static inline T add(T a, T b) { return a + b; }
+	static inline T half(T n) { return n / 2; }
+	static inline T floorHalf(T n) { return std::floor(n / 2); }
+	static inline T floorEven(T n) { return 2 * std::floor(n / 2); }
+};
+
+
+template <typename T> struct ElemTypeInfo : public IntElemOps<T> {
 	static constexpr bool specialized = false;
 	static constexpr bool intBased = true;
 	static constexpr EElemType elemType = ELEM_NONE;
@@ -546,7 +618,7 @@ template <typename T> struct ElemTypeInfo {
 };
 
 
-template <> struct ElemTypeInfo<float> {
+template <> struct ElemTypeInfo<float> : public RealElemOps<float> {
 	static constexpr bool specialized = true;
 	static constexpr bool intBased = false;
 	static constexpr EElemType elemType = ELEM_FLOAT;
@@ -557,7 +629,7 @@ template <> struct ElemTypeInfo<float> {
 };
 
 
-template <> struct ElemTypeInfo<double> {
+template <> struct ElemTypeInfo<double> : public RealElemOps<double> {
 	static constexpr bool specialized = true;
 	static constexpr bool intBased = false;
 	static constexpr EElemType elemType = ELEM_DOUBLE;
@@ -568,7 +640,7 @@ template <> struct ElemTypeInfo<double> {
 };
 
 
-template <> struct ElemTypeInfo<long double> {
+template <> struct ElemTypeInfo<long double> : public RealElemOps<long double> {
 	static constexpr bool specialized = true;
 	static constexpr bool intBased = false;
 	static constexpr EElemType elemType = ELEM_LDOUBLE;
@@ -579,6 +651,28 @@ template <> struct ElemTypeInfo<long double> {
 };
 
 
+template <> struct ElemTypeInfo<int32_t> : public IntElemOps<int32_t> {
+	static constexpr bool specialized = true;
+	static constexpr bool intBased = true;
+	static constexpr EElemType elemType = ELEM_INT32;
+	static constexpr size_t elemSize = sizeof(int32_t);
+	static inline int32_t infinity() { return std::numeric_limits<int32_t>::max(); }
+	static inline int32_t floor(int32_t n) { return n; }
+	static inline int32_t mod(int32_t n, int32_t d) { return n % d; }
+};
+
+
+template <> struct ElemTypeInfo<int64_t> : public IntElemOps<int64_t> {
+	static constexpr bool specialized = true;
+	static constexpr bool intBased = true;
+	static constexpr EElemType elemType = ELEM_INT64;
+	static constexpr size_t elemSize = sizeof(int64_t);
+	static inline int64_t infinity() { return std::numeric_limits<int64_t>::max(); }
+	static inline int64_t floor(int64_t n) { return n; }
+	static inline int64_t mod(int64_t n, int64_t d) { return n % d; }
+};
+
+
 }
 
 
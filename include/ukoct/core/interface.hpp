@@ -16,10 +16,15 @@ public:
 	OperatorArgs()
 		: _state()
 		, _other(NULL)
+		, _others(NULL)
+		, _numOthers(0)
+		, _dest(NULL)
+		, _thresholds(NULL)
 		, _intBased(false)
 		, _waiting(true)
 		, _iterations(0)
 		, _var(0)
+		, _vars(NULL)
 		, _diffCons()
 		, _octCons()
 		{}
@@ -27,24 +32,56 @@ public:
 	OperatorArgs(IState<T>& state)
 		: _state(state)
 		, _other(NULL)
+		, _others(NULL)
+		, _numOthers(0)
+		, _dest(NULL)
+		, _thresholds(NULL)
 		, _intBased(false)
 		, _waiting(true)
 		, _iterations(0)
 		, _var(0)
+		, _vars(NULL)
 		, _diffCons()
 		, _octCons()
 		{}
 	inline IState<T>& state() const { return _state; }
 	inline IState<T>* other() const { return _other; }
 	inline OperatorArgs<T>& other(IState<T>* v) { _other = v; return *this; }
+	/**
+	 * Further operands, besides state() and other(), of operators with the
+	 * O_IMPL_NARY detail, which combine all of them in a single pass.
+	 */
+	inline IState<T>* const* others() const { return _others; }
+	inline size_t numOthers() const { return _numOthers; }
+	inline OperatorArgs<T>& others(IState<T>* const* v, size_t n) { _others = v; _numOthers = n; return *this; }
+	/**
+	 * Where operators with the O_IMPL_DEST detail write their result instead
+	 * of state(), which is then left untouched. NULL means state().
+	 */
+	inline IState<T>* dest() const { return _dest; }
+	inline OperatorArgs<T>& dest(IState<T>* v) { _dest = v; return *this; }
+	/**
+	 * Ascending thresholds for widening, which are tried before infinity
+	 * when a bound grows. They're compared with the matrix entries, which
+	 * hold twice the bounds of single variables. NULL means none.
+	 */
+	inline const std::vector<T>* thresholds() const { return _thresholds; }
+	inline OperatorArgs<T>& thresholds(const std::vector<T>* v) { _thresholds = v; return *this; }
 	inline bool intBased() const { return _intBased; }
 	inline OperatorArgs<T>& intBased(bool v) { _intBased = v; return *this; }
 	inline bool waiting() const { return _waiting; }
-	inline OperatorArgs<T>* waiting(bool v) { _waiting = v; return *this; }
+	inline OperatorArgs<T>& waiting(bool v) { _waiting = v; return *this; }
 	inline size_t iterations() const { return _iterations; }
 	inline OperatorArgs<T>& iterations(size_t v) { _iterations = v; return *this; }
 	inline plas::var_t var() const { return _var; }
 	inline OperatorArgs<T>& var(plas::var_t v) { _var = v; return *this; }
+	/**
+	 * Octagonal variables (1-based) of the dimension operators: those removed
+	 * by OPER_REMOVEDIMS, the positions of those inserted by OPER_ADDDIMS, or
+	 * for OPER_PERMUTEDIMS, the new position of each variable. NULL means none.
+	 */
+	inline const std::vector<plas::var_t>* vars() const { return _vars; }
+	inline OperatorArgs<T>& vars(const std::vector<plas::var_t>* v) { _vars = v; return *this; }
 	inline plas::OctDiffConstraint<T> diffCons() const { return _diffCons; }
 	inline OperatorArgs<T>& diffCons(plas::OctDiffConstraint<T> v) { _diffCons = v; return *this; }
 	inline plas::OctConstraint<T> octCons() const { return _octCons; }
@@ -53,10 +90,15 @@ public:
 private:
 	IState<T>& _state;
 	IState<T>* _other;
+	IState<T>* const* _others;
+	size_t _numOthers;
+	IState<T>* _dest;
+	const std::vector<T>* _thresholds;
 	bool _intBased;
 	bool _waiting;
 	size_t _iterations;
 	plas::var_t _var;
+	const std::vector<plas::var_t>* _vars;
 	plas::OctDiffConstraint<T> _diffCons;
 	plas::OctConstraint<T> _octCons;
 };
@@ -156,7 +198,7 @@ template <typename T> struct IImplementation {
 	virtual IOperator<T>* newOperator(EOperation oper, OperationDetails details = 0, bool matchAnyDetails = false) const {
 		std::vector<IOperator<T>*> ops;
 		filterOperators(ops, 1, oper, details, matchAnyDetails);
-		return ops.back();
+		return ops.empty() ? NULL : ops.back();
 	}
 
 	inline bool operator==(const IImplementation<T>& other) const {
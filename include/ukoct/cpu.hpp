@@ -3,8 +3,15 @@
 
 #include "ukoct/core.hpp"
 #include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/allocator.hpp"
+#include "ukoct/cpu/snapshot.hpp"
+#include "ukoct/cpu/pool.hpp"
+#include "ukoct/cpu/simd.hpp"
+#include "ukoct/cpu/sparse.hpp"
+#include "ukoct/cpu/view.hpp"
 #include "ukoct/cpu/operators.hpp"
 #include "ukoct/cpu/state.hpp"
+#include "ukoct/cpu/half/state.hpp"
 
 
 #endif /* UKOCT_CPU_HPP_ */
@@ -0,0 +1,149 @@
+#ifndef UKOCT_CPU_ALLOCATOR_HPP_
+#define UKOCT_CPU_ALLOCATOR_HPP_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <new>
+
+#include "ukoct/cpu/base.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Source of the matrix buffers of CPU states.
+ *
+ * Buffers are aligned to ukoct_CPU_ALIGNMENT bytes, and given back with the
+ * same size they were requested with. Allocators are shared by all states of
+ * an implementation, possibly from several threads at once.
+ */
+class CpuAllocator {
+public:
+	virtual ~CpuAllocator() {}
+	virtual void* allocate(size_t bytes) = 0;
+	virtual void release(void* ptr, size_t bytes) = 0;
+
+
+	/**
+	 * Row pitch (in elements) for a matrix of `n` columns, such that every
+	 * row of an aligned buffer starts on a ukoct_CPU_ALIGNMENT boundary.
+	 */
+	template <typename T> static size_t pitch(size_t n) {
+		size_t a = ukoct_CPU_ALIGNMENT, b = sizeof(T);
+		while (b != 0) {
+			size_t r = a % b;
+			a = b;
+			b = r;
+		}
+
+		size_t step = ukoct_CPU_ALIGNMENT / a;
+		return (n + step - 1) / step * step;
+	}
+
+
+protected:
+	/* Aligned allocation from the global heap, keeping the offset right before the buffer. */
+	static void* alignedNew(size_t bytes) {
+		char* base = static_cast<char*>(::operator new(bytes + ukoct_CPU_ALIGNMENT + sizeof(size_t)));
+		uintptr_t addr = reinterpret_cast<uintptr_t>(base) + sizeof(size_t);
+		addr = (addr + ukoct_CPU_ALIGNMENT - 1) & ~static_cast<uintptr_t>(ukoct_CPU_ALIGNMENT - 1);
+		char* ptr = reinterpret_cast<char*>(addr);
+		reinterpret_cast<size_t*>(ptr)[-1] = ptr - base;
+		return ptr;
+	}
+
+
+	static void alignedDelete(void* ptr) {
+		if (ptr != NULL) {
+			char* p = static_cast<char*>(ptr);
+			::operator delete(p - reinterpret_cast<size_t*>(p)[-1]);
+		}
+	}
+};
+
+
+/**
+ * The default allocator: an arena which keeps released buffers in per-size
+ * free lists and hands them out again, so that states of the same size
+ * being created and destroyed over and over don't go through the global
+ * heap. At most ukoct_CPU_ARENABYTES bytes are kept; buffers released
+ * beyond that are freed.
+ */
+class CpuArenaAllocator : public CpuAllocator {
+public:
+	CpuArenaAllocator() :
+		_cached(0) {}
+
+
+	~CpuArenaAllocator() {
+		clear();
+	}
+
+
+	void* allocate(size_t bytes) {
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			std::map<size_t, std::vector<void*> >::iterator it = _free.find(bytes);
+			if (it != _free.end() && !it->second.empty()) {
+				void* ptr = it->second.back();
+				it->second.pop_back();
+				_cached -= bytes;
+				return ptr;
+			}
+		}
+
+		return alignedNew(bytes);
+	}
+
+
+	void release(void* ptr, size_t bytes) {
+		if (ptr == NULL)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_cached + bytes <= ukoct_CPU_ARENABYTES) {
+				_free[bytes].push_back(ptr);
+				_cached += bytes;
+				return;
+			}
+		}
+
+		alignedDelete(ptr);
+	}
+
+
+	/** Bytes currently kept for reuse. */
+	size_t cached() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _cached;
+	}
+
+
+	/** Frees all buffers kept for reuse. */
+	void clear() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (std::map<size_t, std::vector<void*> >::iterator it = _free.begin(); it != _free.end(); ++it)
+			for (size_t i = 0; i < it->second.size(); ++i)
+				alignedDelete(it->second[i]);
+		_free.clear();
+		_cached = 0;
+	}
+
+private:
+	CpuArenaAllocator(const CpuArenaAllocator&);
+	CpuArenaAllocator& operator=(const CpuArenaAllocator&);
+
+	mutable std::mutex _mutex;
+	std::map<size_t, std::vector<void*> > _free;
+	size_t _cached;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_ALLOCATOR_HPP_ */
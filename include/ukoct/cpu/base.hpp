@@ -1,6 +1,37 @@
 #ifndef UKOCT_CPU_BASE_HPP_
 #define UKOCT_CPU_BASE_HPP_
 
+// Amount of cache memory (in bytes) a tile-based operator should target when
+// choosing its block sizes. Defaults to a common L1 data cache size.
+#ifndef ukoct_CPU_BLOCKBYTES
+#	define ukoct_CPU_BLOCKBYTES 32768
+#endif
+
+// Minimum diffSize for which operators split their work amongst the threads
+// of a CpuImplementation's pool. Smaller problems are run sequentially.
+#ifndef ukoct_CPU_PARALLELSIZE
+#	define ukoct_CPU_PARALLELSIZE 64
+#endif
+
+// Fraction of finite entries in a pair of pivot rows below which closure
+// relaxes only the finite columns, instead of running the dense row kernel.
+#ifndef ukoct_CPU_SPARSEDENSITY
+#	define ukoct_CPU_SPARSEDENSITY 0.25
+#endif
+
+// Alignment (in bytes, a power of 2) of the matrix buffers of CPU states, and
+// of each of their rows. Defaults to a common cache line size, which also
+// covers the widest SIMD registers.
+#ifndef ukoct_CPU_ALIGNMENT
+#	define ukoct_CPU_ALIGNMENT 64
+#endif
+
+// Maximum amount of memory (in bytes) the default CPU allocator keeps from
+// destroyed states for reuse.
+#ifndef ukoct_CPU_ARENABYTES
+#	define ukoct_CPU_ARENABYTES (64 << 20)
+#endif
+
 namespace ukoct {
 
 template <typename T> class CpuImplementation;
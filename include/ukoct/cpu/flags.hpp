@@ -0,0 +1,149 @@
+#ifndef UKOCT_CPU_FLAGS_HPP_
+#define UKOCT_CPU_FLAGS_HPP_
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/** Properties of a DBM state which may be known without checking its matrix. */
+enum ECpuStateFlag {
+	CPUSTATE_CONSISTENT = 1 << 0,     //!< @see IsConsistentCpuOperator
+	CPUSTATE_COHERENT = 1 << 1,       //!< @see IsCoherentCpuOperator
+	CPUSTATE_CLOSED = 1 << 2,         //!< @see IsClosedCpuOperator
+	CPUSTATE_STRONGLYCLOSED = 1 << 3, //!< @see IsStronglyClosedCpuOperator
+	CPUSTATE_TIGHTLYCLOSED = 1 << 4,  //!< @see IsTightlyClosedCpuOperator
+	CPUSTATE_ALL = (1 << 5) - 1
+};
+
+
+/**
+ * Known properties of a CpuState, so that closures and predicates can be
+ * answered without going through the matrix again.
+ *
+ * Each flag is either unknown, known to hold or known to fail. They are
+ * kept by the operators when run on their own (see AbstractCpuOperator), and
+ * mutators forget all of them by default.
+ */
+class CpuStateFlags {
+public:
+	CpuStateFlags() :
+		_known(0),
+		_values(0) {}
+
+
+	bool known(unsigned int flag) const {
+		return (_known & flag) == flag;
+	}
+
+
+	/** All known flags. */
+	unsigned int knownMask() const {
+		return _known;
+	}
+
+
+	/** All flags known to hold. */
+	unsigned int valueMask() const {
+		return _values;
+	}
+
+
+	/** Whether all given flags are known to hold. */
+	bool holds(unsigned int flags) const {
+		return known(flags) && (_values & flags) == flags;
+	}
+
+
+	/** Whether the given flag is known to fail. */
+	bool fails(unsigned int flag) const {
+		return known(flag) && (_values & flag) == 0;
+	}
+
+
+	void set(unsigned int flags, bool value) {
+		_known |= flags;
+		if (value)
+			_values |= flags;
+		else
+			_values &= ~flags;
+	}
+
+
+	void forget(unsigned int flags = CPUSTATE_ALL) {
+		_known &= ~flags;
+		_values &= ~flags;
+	}
+
+
+	/** Forgets all flags but the given ones, which are kept only if they hold. */
+	void retain(unsigned int flags) {
+		forget(CPUSTATE_ALL & ~(flags & _known & _values));
+	}
+
+
+	/**
+	 * To be called after zeroing the diagonal of a consistent matrix, which
+	 * preserves all properties but may make an incoherent matrix coherent.
+	 */
+	void zeroedDiagonal() {
+		if (fails(CPUSTATE_COHERENT))
+			forget(CPUSTATE_COHERENT);
+	}
+
+	/**
+	 * Flags of the elementwise maximum of two matrices. Consistency holds if
+	 * it holds for either, as no cycle gets shorter, and the closures and
+	 * coherence hold if they hold for both.
+	 */
+	static CpuStateFlags ofUnion(const CpuStateFlags& a, const CpuStateFlags& b) {
+		CpuStateFlags ret;
+		ret.set(a.valueMask() & b.valueMask(), true);
+		if (a.holds(CPUSTATE_CONSISTENT) || b.holds(CPUSTATE_CONSISTENT))
+			ret.set(CPUSTATE_CONSISTENT, true);
+		return ret;
+	}
+
+
+	/**
+	 * Flags of the elementwise minimum of two matrices. Coherence holds if it
+	 * holds for both, and consistency fails if it fails for either.
+	 */
+	static CpuStateFlags ofIntersection(const CpuStateFlags& a, const CpuStateFlags& b) {
+		CpuStateFlags ret;
+		ret.set(a.valueMask() & b.valueMask() & CPUSTATE_COHERENT, true);
+		if (a.fails(CPUSTATE_CONSISTENT) || b.fails(CPUSTATE_CONSISTENT))
+			ret.set(CPUSTATE_CONSISTENT, false);
+		return ret;
+	}
+
+	/**
+	 * Flags of the widening of a matrix by another. No entry gets smaller, so
+	 * consistency holds if it holds for the first, and coherence holds if it
+	 * holds for both. The closures are lost.
+	 */
+	static CpuStateFlags ofWidening(const CpuStateFlags& a, const CpuStateFlags& b) {
+		CpuStateFlags ret;
+		ret.set(a.valueMask() & b.valueMask() & CPUSTATE_COHERENT, true);
+		if (a.holds(CPUSTATE_CONSISTENT))
+			ret.set(CPUSTATE_CONSISTENT, true);
+		return ret;
+	}
+
+
+	/** Flags of the narrowing of a matrix by another, of which only coherence is kept when it holds for both. */
+	static CpuStateFlags ofNarrowing(const CpuStateFlags& a, const CpuStateFlags& b) {
+		CpuStateFlags ret;
+		ret.set(a.valueMask() & b.valueMask() & CPUSTATE_COHERENT, true);
+		return ret;
+	}
+
+private:
+	unsigned int _known;
+	unsigned int _values;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_FLAGS_HPP_ */
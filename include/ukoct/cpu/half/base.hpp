@@ -0,0 +1,33 @@
+#ifndef UKOCT_CPU_HALF_BASE_HPP_
+#define UKOCT_CPU_HALF_BASE_HPP_
+
+#include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/operators/abstract.hpp"
+
+namespace ukoct {
+
+template <typename T> class CpuHalfImplementation;
+template <typename T> class CpuHalfState;
+
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T, ukoct::EOperation Oper> struct OperationImpl {
+	static constexpr bool valid = false;
+	typedef octdiff::NopCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = Oper;
+	static constexpr ukoct::OperationDetails details() { return 0; }
+};
+
+using octdiff::CpuResult;
+using octdiff::AbstractCpuOperator;
+
+}
+}
+}
+
+}
+
+#endif /* UKOCT_CPU_HALF_BASE_HPP_ */
@@ -0,0 +1,31 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_HPP_
+
+
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators/copy.hpp"
+
+#include "ukoct/cpu/half/operators/isConsistent.hpp"
+#include "ukoct/cpu/half/operators/isIntConsistent.hpp"
+#include "ukoct/cpu/half/operators/isCoherent.hpp"
+#include "ukoct/cpu/half/operators/isTop.hpp"
+
+#include "ukoct/cpu/half/operators/shortestPath.hpp"
+#include "ukoct/cpu/half/operators/strengthen.hpp"
+#include "ukoct/cpu/half/operators/tighten.hpp"
+#include "ukoct/cpu/half/operators/top.hpp"
+
+#include "ukoct/cpu/half/operators/closure.hpp"
+#include "ukoct/cpu/half/operators/tightClosure.hpp"
+#include "ukoct/cpu/half/operators/equals.hpp"
+#include "ukoct/cpu/half/operators/includes.hpp"
+
+#include "ukoct/cpu/half/operators/union.hpp"
+#include "ukoct/cpu/half/operators/intersection.hpp"
+#include "ukoct/cpu/half/operators/pushDiffCons.hpp"
+#include "ukoct/cpu/half/operators/pushOctCons.hpp"
+#include "ukoct/cpu/half/operators/forgetOctVar.hpp"
+#include "ukoct/cpu/half/operators/incClosure.hpp"
+
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_HPP_ */
@@ -0,0 +1,58 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_CLOSURE_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_CLOSURE_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators/shortestPath.hpp"
+#include "ukoct/cpu/half/operators/isConsistent.hpp"
+#include "ukoct/cpu/half/operators/strengthen.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_CLOSURE
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class ClosureCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef ClosureCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class ClosureCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ShortestPathCpuHalfOperator<T> shortestPath;
+		IsConsistentCpuHalfOperator<T> isConsistent;
+		StrengthenCpuHalfOperator<T> strengthen;
+
+		shortestPath.run(args, ret);
+
+		if (ret.boolResult)
+			isConsistent.run(args, ret);
+
+		if (ret.boolResult)
+			strengthen.run(args, ret);
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_CLOSURE_HPP_ */
@@ -0,0 +1,56 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_FORGETOCTVAR_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_FORGETOCTVAR_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_FORGETOCTVAR
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class ForgetOctVarCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef ForgetOctVarCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class ForgetOctVarCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		T infinity = state.implementation().infinity();
+		plas::var_t v = plas::normalizeVar(args.var());
+
+		ukoct_ASSERT(v > 0 && v <= state.octSize(), "Variable out of range, should be in between 1 and octSize.");
+
+		// Resetting both rows of the variable also resets its columns,
+		// since they are the same elements.
+		for (size_t i = 2 * v - 2; i < 2 * (size_t) v; ++i) {
+			for (size_t j = 0; j < state.diffSize(); ++j)
+				state.at(i, j) = i == j ? 0 : infinity;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_FORGETOCTVAR_HPP_ */
@@ -0,0 +1,80 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_INCCLOSURE_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_INCCLOSURE_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators/pushDiffCons.hpp"
+#include "ukoct/cpu/half/operators/isConsistent.hpp"
+#include "ukoct/cpu/half/operators/isIntConsistent.hpp"
+#include "ukoct/cpu/half/operators/strengthen.hpp"
+#include "ukoct/cpu/half/operators/tighten.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_INCCLOSURE
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class IncClosureCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef IncClosureCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class IncClosureCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		plas::OctConstraint<T> f = args.octCons();
+		plas::OctDiffConstraint<T> ca = args.diffCons();
+		plas::OctDiffConstraint<T> cb;
+
+		if (f.valid())
+			f.split(ca, cb);
+
+		ukoct_ASSERT(ca.valid(), "A constraint must be provided for this operator.");
+		PushDiffConsCpuHalfOperator<T>::push(state, ca.a() - 1, ca.b() - 1, ca.d());
+
+		// The second constraint is usually the coherent counterpart of the
+		// first one, which has already been pushed along with it.
+		if (cb.valid() && (cb.a() != ca.B() || cb.b() != ca.A() || cb.d() != ca.d()))
+			PushDiffConsCpuHalfOperator<T>::push(state, cb.a() - 1, cb.b() - 1, cb.d());
+
+		IsConsistentCpuHalfOperator<T> isConsistent;
+		isConsistent.run(args, ret);
+
+		if (ret.boolResult) {
+			if (args.intBased()) {
+				TightenCpuHalfOperator<T> tighten;
+				IsIntConsistentCpuHalfOperator<T> isIntConsistent;
+				tighten.run(args, ret);
+				isIntConsistent.run(args, ret);
+
+			} else {
+				StrengthenCpuHalfOperator<T> strengthen;
+				strengthen.run(args, ret);
+			}
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_INCCLOSURE_HPP_ */
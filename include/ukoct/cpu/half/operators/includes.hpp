@@ -0,0 +1,60 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_INCLUDES_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_INCLUDES_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_INCLUDES
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class IncludesCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef IncludesCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT; }
+};
+
+template <typename T> class IncludesCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		ukoct::CpuHalfState<T>& other = *reinterpret_cast<CpuHalfState<T>*>(args.other());
+		const T* mat = state.raw();
+		const T* oth = other.raw();
+		ret.boolResult = true;
+
+		if (&state != &other) {
+			if (state.diffSize() != other.diffSize())
+				ret.boolResult = false;
+
+			for (size_t k = 0; k < state.packedSize() && ret.boolResult; ++k)
+				if (oth[k] > mat[k])
+					ret.boolResult = false;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_INCLUDES_HPP_ */
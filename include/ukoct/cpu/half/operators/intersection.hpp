@@ -0,0 +1,56 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_INTERSECTION_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_INTERSECTION_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_INTERSECTION
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class IntersectionCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef IntersectionCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class IntersectionCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		ukoct::CpuHalfState<T>& other = *reinterpret_cast<CpuHalfState<T>*>(args.other());
+		ret.boolResult = true;
+
+		if (&state != &other) {
+			if (state.diffSize() != other.diffSize())
+				throw Error("Problem sizes cannot be different.");
+
+			impl::cpu::CpuKernels<T>::get().min(state.raw(), state.raw(), other.raw(), state.packedSize());
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_INTERSECTION_HPP_ */
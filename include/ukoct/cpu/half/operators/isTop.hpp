@@ -0,0 +1,54 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_ISTOP_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_ISTOP_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_ISTOP
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class IsTopCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef IsTopCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT; }
+};
+
+template <typename T> class IsTopCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		T infinity = state.implementation().infinity();
+		ret.boolResult = true;
+
+		for (size_t i = 0; i < state.diffSize() && ret.boolResult; ++i) {
+			const T* row = state.row(i);
+			for (size_t j = 0; j < CpuHalfState<T>::rowSize(i) && ret.boolResult; ++j)
+				if (i != j && row[j] != infinity)
+					ret.boolResult = false;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_ISTOP_HPP_ */
@@ -0,0 +1,80 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_PUSHDIFFCONS_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_PUSHDIFFCONS_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_PUSHDIFFCONS
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class PushDiffConsCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef PushDiffConsCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class PushDiffConsCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		plas::OctDiffConstraint<T> f = args.diffCons();
+		push(state, f.a() - 1, f.b() - 1, f.d());
+		ret.boolResult = true;
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+	/**
+	 * Adds the edge a -> b (0-based) with weight d, along with its coherent
+	 * counterpart B -> A, to a closed state, keeping it closed. Any shortest
+	 * path uses each new edge at most once, so it suffices to consider
+	 * reaching b either directly through a -> b or through B -> A -> a -> b
+	 * (and conversely for A), which amounts to relaxing every row with the
+	 * rows b and A as a pivot pair.
+	 */
+	static void push(CpuHalfState<T>& state, size_t a, size_t b, T d) {
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		size_t n = state.diffSize();
+		size_t A = a ^ 1;
+		size_t B = b ^ 1;
+		std::vector<T> pivotRows(2 * n);
+		T* rb = &pivotRows[0];
+		T* rA = &pivotRows[n];
+
+		for (size_t j = 0; j < n; ++j) {
+			rb[j] = state.at(b, j);
+			rA[j] = state.at(A, j);
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			size_t I = i ^ 1;
+			T ia = rA[I]; // m[ia] = m[AI]
+			T iB = rb[I]; // m[iB] = m[bI]
+			T ib = ElemTypeInfo<T>::add(std::min(ia, ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(iB, d), rA[a])), d);
+			T iA = ElemTypeInfo<T>::add(std::min(iB, ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(ia, d), rb[B])), d);
+			kernels.relaxPair(state.row(i), rb, rA, ib, iA, CpuHalfState<T>::rowSize(i));
+		}
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_PUSHDIFFCONS_HPP_ */
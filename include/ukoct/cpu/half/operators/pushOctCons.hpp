@@ -0,0 +1,56 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_PUSHOCTCONS_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_PUSHOCTCONS_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators/pushDiffCons.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_PUSHOCTCONS
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class PushOctConsCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef PushOctConsCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class PushOctConsCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		plas::OctDiffConstraint<T> ca, cb;
+		args.octCons().split(ca, cb);
+		PushDiffConsCpuHalfOperator<T>::push(state, ca.a() - 1, ca.b() - 1, ca.d());
+
+		// The second constraint is usually the coherent counterpart of the
+		// first one, which has already been pushed along with it.
+		if (cb.valid() && (cb.a() != plas::switchVar(ca.b()) || cb.b() != plas::switchVar(ca.a()) || cb.d() != ca.d()))
+			PushDiffConsCpuHalfOperator<T>::push(state, cb.a() - 1, cb.b() - 1, cb.d());
+
+		ret.boolResult = true;
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_PUSHOCTCONS_HPP_ */
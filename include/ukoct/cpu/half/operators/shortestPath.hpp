@@ -0,0 +1,122 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_SHORTESTPATH_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_SHORTESTPATH_HPP_
+
+#include <atomic>
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_SHORTESTPATH
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class ShortestPathCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef ShortestPathCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class ShortestPathCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		size_t n = state.diffSize();
+		size_t iters = args.iterations();
+		std::vector<T> pivotRows(2 * n);
+		T* rk = &pivotRows[0];
+		T* rK = &pivotRows[n];
+		impl::cpu::CpuPivotIndex<T> pivots(n, state.implementation().infinity());
+		std::atomic<bool> consistent(true);
+
+		if (iters == 0 || iters > state.octSize())
+			iters = state.octSize();
+
+		if (state.cpuImplementation().parallel(n)) {
+			impl::cpu::CpuThreadPool& pool = *state.cpuImplementation().pool();
+
+			pool.run([&](size_t worker, size_t numWorkers) {
+				size_t begin, end;
+				CpuHalfState<T>::range(n, worker, numWorkers, begin, end);
+
+				for (size_t k = 0; k < 2 * iters && consistent; k += 2) {
+					if (worker == 0) {
+						copyPivotRows(state, k, rk, rK);
+						pivots.build(rk, rK, n);
+					}
+					pool.barrier().wait();
+
+					if (!relaxRows(state, begin, end, k, rk, rK, pivots))
+						consistent = false;
+					pool.barrier().wait();
+				}
+			});
+
+		} else for (size_t k = 0; k < 2 * iters && consistent; k += 2) {
+			copyPivotRows(state, k, rk, rK);
+			pivots.build(rk, rK, n);
+			if (!relaxRows(state, 0, n, k, rk, rK, pivots))
+				consistent = false;
+		}
+
+		// As with full matrices, the closure stops at the first negative cycle
+		ret.boolResult = consistent;
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+private:
+	/*
+	 * Expands rows k and K = k + 1 into full length copies. Because of
+	 * coherence, they also hold the pivot columns: m[ik] = m[KI] and
+	 * m[iK] = m[kI].
+	 */
+	static void copyPivotRows(CpuHalfState<T>& state, size_t k, T* rk, T* rK) {
+		for (size_t j = 0; j < state.diffSize(); ++j) {
+			rk[j] = state.at(k, j);
+			rK[j] = state.at(k + 1, j);
+		}
+	}
+
+
+	/*
+	 * Same relaxation as the one in the full matrix operator, restricted to
+	 * the stored part of each row, so both yield the same results. The
+	 * diagonal is always stored, and checked in the same way.
+	 */
+	static bool relaxRows(CpuHalfState<T>& state, size_t begin, size_t end, size_t k, const T* rk, const T* rK, const impl::cpu::CpuPivotIndex<T>& pivots) {
+		size_t K = k + 1;
+
+		for (size_t i = begin; i < end; ++i) {
+			size_t I = i ^ 1;
+			T ik = std::min(rK[I], ElemTypeInfo<T>::add(rk[I], rK[k])); // i -> k, or i -> K -> k
+			T iK = std::min(rk[I], ElemTypeInfo<T>::add(rK[I], rk[K])); // i -> K, or i -> k -> K
+			pivots.relax(state.row(i), rk, rK, ik, iK, CpuHalfState<T>::rowSize(i));
+
+			if (state.row(i)[i] < 0)
+				return false;
+		}
+
+		return true;
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_SHORTESTPATH_HPP_ */
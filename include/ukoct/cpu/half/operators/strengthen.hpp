@@ -0,0 +1,71 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_STRENGTHEN_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_STRENGTHEN_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_STRENGTHEN
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class StrengthenCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef StrengthenCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class StrengthenCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuHalfState<T>& state = reinterpret_cast<CpuHalfState<T>&>(args.state());
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		size_t n = state.diffSize();
+		std::vector<T> d(n);
+
+		// The m[Jj] entries are never changed by strengthening, so they are
+		// gathered beforehand (d[I] being m[iI]). Integer-based states get
+		// them tightened first, which keeps the halved sums integral.
+		for (size_t j = 0; j < n; ++j) {
+			T& Jj = state.at(j ^ 1, j);
+			if (args.intBased())
+				Jj = ElemTypeInfo<T>::floorEven(Jj);
+			d[j] = Jj;
+		}
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			CpuHalfState<T>::range(n, worker, numWorkers, begin, end);
+
+			for (size_t i = begin; i < end; ++i)
+				kernels.strengthen(state.row(i), &d[0], d[i ^ 1], CpuHalfState<T>::rowSize(i));
+		};
+
+		if (state.cpuImplementation().parallel(n))
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_STRENGTHEN_HPP_ */
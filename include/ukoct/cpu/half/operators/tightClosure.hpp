@@ -0,0 +1,62 @@
+#ifndef UKOCT_CPU_HALF_OPERATORS_TIGHTCLOSURE_HPP_
+#define UKOCT_CPU_HALF_OPERATORS_TIGHTCLOSURE_HPP_
+
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators/shortestPath.hpp"
+#include "ukoct/cpu/half/operators/isConsistent.hpp"
+#include "ukoct/cpu/half/operators/isIntConsistent.hpp"
+#include "ukoct/cpu/half/operators/tighten.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_TIGHTCLOSURE
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octhalf {
+
+template <typename T> class TightClosureCpuHalfOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef TightClosureCpuHalfOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+template <typename T> class TightClosureCpuHalfOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ShortestPathCpuHalfOperator<T> shortestPath;
+		IsConsistentCpuHalfOperator<T> isConsistent;
+		IsIntConsistentCpuHalfOperator<T> isIntConsistent;
+		TightenCpuHalfOperator<T> tighten;
+
+		shortestPath.run(args, ret);
+
+		if (ret.boolResult)
+			isConsistent.run(args, ret);
+
+		if (ret.boolResult) {
+			tighten.run(args, ret);
+			isIntConsistent.run(args, ret);
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_HALF_OPERATORS_TIGHTCLOSURE_HPP_ */
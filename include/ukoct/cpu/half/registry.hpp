@@ -0,0 +1,61 @@
+#ifndef UKOCT_CPU_HALF_REGISTRY_HPP_
+#define UKOCT_CPU_HALF_REGISTRY_HPP_
+
+#include "ukoct/cpu/registry.hpp"
+#include "ukoct/cpu/half/operators.hpp"
+
+// Entry for the default operator of an operation (see octhalf::OperationImpl)
+#define ukoct_CPUHALFOPERATOR(oper) \
+	{ \
+		OperationImpl<T, oper>::operation, \
+		OperationImpl<T, oper>::details(), \
+		&newCpuOperator<T, typename OperationImpl<T, oper>::Impl> \
+	}
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Lists all operators provided by the half-matrix CPU implementation.
+ *
+ * Operations that are not listed here (e.g. the closure checks) are not
+ * available for half-matrix states.
+ */
+template <typename T> const CpuOperatorEntry<T>* cpuHalfOperators(size_t& size) {
+	using namespace octhalf;
+	static const CpuOperatorEntry<T> entries[] = {
+		  ukoct_CPUHALFOPERATOR(OPER_COPY)
+		, ukoct_CPUHALFOPERATOR(OPER_ISCONSISTENT)
+		, ukoct_CPUHALFOPERATOR(OPER_ISINTCONSISTENT)
+		, ukoct_CPUHALFOPERATOR(OPER_ISCOHERENT)
+		, ukoct_CPUHALFOPERATOR(OPER_ISTOP)
+
+		, ukoct_CPUHALFOPERATOR(OPER_CLOSURE)
+		, ukoct_CPUHALFOPERATOR(OPER_TIGHTCLOSURE)
+		, ukoct_CPUHALFOPERATOR(OPER_SHORTESTPATH)
+		, ukoct_CPUHALFOPERATOR(OPER_STRENGTHEN)
+		, ukoct_CPUHALFOPERATOR(OPER_TIGHTEN)
+		, ukoct_CPUHALFOPERATOR(OPER_TOP)
+
+		, ukoct_CPUHALFOPERATOR(OPER_PUSHDIFFCONS)
+		, ukoct_CPUHALFOPERATOR(OPER_PUSHOCTCONS)
+		, ukoct_CPUHALFOPERATOR(OPER_FORGETOCTVAR)
+		, ukoct_CPUHALFOPERATOR(OPER_INCCLOSURE)
+
+		, ukoct_CPUHALFOPERATOR(OPER_EQUALS)
+		, ukoct_CPUHALFOPERATOR(OPER_INCLUDES)
+		, ukoct_CPUHALFOPERATOR(OPER_UNION)
+		, ukoct_CPUHALFOPERATOR(OPER_INTERSECTION)
+	};
+	size = sizeof(entries) / sizeof(entries[0]);
+	return entries;
+}
+
+}
+}
+}
+
+#undef ukoct_CPUHALFOPERATOR
+
+#endif /* UKOCT_CPU_HALF_REGISTRY_HPP_ */
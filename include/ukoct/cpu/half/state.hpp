@@ -0,0 +1,238 @@
+#ifndef UKOCT_CPU_HALF_STATE_HPP_
+#define UKOCT_CPU_HALF_STATE_HPP_
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "ukoct/cpu/state.hpp"
+#include "ukoct/cpu/half/base.hpp"
+#include "ukoct/cpu/half/operators.hpp"
+#include "ukoct/cpu/half/registry.hpp"
+
+namespace ukoct{
+
+/**
+ * A DBM state storing only half of a coherent matrix, as proposed by Miné.
+ *
+ * Coherence (m[ij] == m[JI]) makes half of the matrix redundant, so only
+ * the elements m[ij] with j <= (i | 1) are kept, packed row by row. Each
+ * pair of rows 2k and 2k + 1 holds 2k + 2 elements, taking
+ * diffSize^2 / 2 + diffSize elements in total. All indices in this class are
+ * 0-based, and rows are always stored in row-major order; rowMajor() only
+ * tells the ordering used by setup() and copyTo().
+ *
+ * setup() takes the tightest coherent version of its input, i.e.
+ * min(m[ij], m[JI]) for each element.
+ */
+template <typename T> class CpuHalfState : public IState<T> {
+public:
+	CpuHalfState() :
+		_valid(false),
+		_impl(NULL),
+		_diffSize(0),
+		_rowMajor(true),
+		_self() {}
+
+
+	CpuHalfState(const CpuHalfState<T>& other) = default;
+
+
+	CpuHalfState(const CpuHalfImplementation<T>* impl) :
+		_valid(false),
+		_impl(impl),
+		_diffSize(0),
+		_rowMajor(true),
+		_self() {}
+
+
+	const IImplementation<T>& implementation() const {
+		ukoct::assert(_impl != NULL, "Missing internal IImplementation pointer.");
+		return *_impl;
+	}
+
+
+	const CpuHalfImplementation<T>& cpuImplementation() const {
+		ukoct::assert(_impl != NULL, "Missing internal IImplementation pointer.");
+		return *_impl;
+	}
+
+
+	CpuHalfState<T>* clone() const {
+		return new CpuHalfState<T>(*this);
+	}
+
+
+	bool isValid() const {
+		return _impl != NULL && _valid;
+	}
+
+
+	size_t implSize() const {
+		return _diffSize;
+	}
+
+
+	bool rowMajor() const {
+		return _rowMajor;
+	}
+
+
+	void copyTo(T* ptr) const {
+		size_t n = _diffSize;
+
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				ptr[_rowMajor ? i * n + j : j * n + i] = at(i, j);
+	}
+
+
+	void setup(size_t diffSize, T* rawInput, bool rowMajor) {
+		assertStateOptions(_valid, diffSize, rawInput, rowMajor);
+		size_t n = diffSize;
+		_diffSize = diffSize;
+		_rowMajor = rowMajor;
+		_self.assign(packedSize(n), implementation().infinity());
+
+		for (size_t i = 0; i < n; ++i) {
+			T* r = row(i);
+			for (size_t j = 0; j < rowSize(i); ++j) {
+				size_t I = i ^ 1;
+				size_t J = j ^ 1;
+				T ij = rowMajor ? rawInput[i * n + j] : rawInput[j * n + i];
+				T JI = rowMajor ? rawInput[J * n + I] : rawInput[I * n + J];
+				r[j] = std::min(ij, JI);
+			}
+		}
+
+		_valid = true;
+	}
+
+
+	/** Number of elements stored for a given diffSize. */
+	static inline size_t packedSize(size_t diffSize) {
+		return (diffSize * diffSize) / 2 + diffSize;
+	}
+
+
+	/** Number of elements stored in row i. */
+	static inline size_t rowSize(size_t i) {
+		return (i | 1) + 1;
+	}
+
+
+	/** Position of m[ij] in the packed buffer, for j <= (i | 1). */
+	static inline size_t index(size_t i, size_t j) {
+		return j + ((i + 1) * (i + 1)) / 2;
+	}
+
+
+	/**
+	 * Calculates the range of rows a worker is responsible for. Since row
+	 * sizes grow linearly, rows are distributed so that each worker gets
+	 * about the same number of elements, and ranges start at even rows.
+	 */
+	static void range(size_t diffSize, size_t worker, size_t numWorkers, size_t& begin, size_t& end) {
+		begin = rowBoundary(diffSize, worker, numWorkers);
+		end = rowBoundary(diffSize, worker + 1, numWorkers);
+	}
+
+
+	size_t packedSize() const {
+		return _self.size();
+	}
+
+
+	/** Accesses any element m[ij], resorting to m[JI] when it's not stored. */
+	inline T& at(size_t i, size_t j) {
+		return j <= (i | 1) ? _self[index(i, j)] : _self[index(j ^ 1, i ^ 1)];
+	}
+
+
+	inline const T& at(size_t i, size_t j) const {
+		return j <= (i | 1) ? _self[index(i, j)] : _self[index(j ^ 1, i ^ 1)];
+	}
+
+
+	/** The stored part of row i, with rowSize(i) elements. */
+	inline T* row(size_t i) {
+		return &_self[index(i, 0)];
+	}
+
+
+	inline const T* row(size_t i) const {
+		return &_self[index(i, 0)];
+	}
+
+
+	T* raw() {
+		return &_self[0];
+	}
+
+
+	const T* raw() const {
+		return &_self[0];
+	}
+
+private:
+	static size_t rowBoundary(size_t diffSize, size_t worker, size_t numWorkers) {
+		if (worker >= numWorkers)
+			return diffSize;
+		size_t r = (size_t) (diffSize * std::sqrt((double) worker / numWorkers));
+		return std::min(diffSize, r & ~((size_t) 1));
+	}
+
+private:
+	bool _valid;
+	const ukoct::CpuHalfImplementation<T>* _impl;
+	size_t _diffSize;
+	bool _rowMajor;
+	std::vector<T> _self;
+};
+
+
+/**
+ * The half-matrix CPU implementation.
+ *
+ * Works just like CpuImplementation, including its thread pool, but its
+ * states are CpuHalfState instances, which take about half the memory.
+ * Its states cannot be mixed with full matrix ones.
+ */
+template <typename T> class CpuHalfImplementation : public AbstractCpuImplementation<T> {
+public:
+	explicit CpuHalfImplementation(size_t numThreads = 1) :
+		AbstractCpuImplementation<T>(numThreads) {}
+
+
+	EImplementation type() const {
+		return IMPL_CPUHALF;
+	}
+
+
+	CpuHalfState<T>* newState() const {
+		return new CpuHalfState<T>(this);
+	}
+
+protected:
+	const impl::cpu::CpuOperatorEntry<T>* operatorEntries(size_t& size) const {
+		return impl::cpu::cpuHalfOperators<T>(size);
+	}
+};
+
+
+template <typename T> struct ImplementationInfo<T, IMPL_CPUHALF> {
+	static constexpr bool valid = true;
+	static constexpr EImplementation type = IMPL_CPUHALF;
+	static constexpr bool intBased = ElemTypeInfo<T>::intBased;
+	static constexpr EElemType elemType = ElemTypeInfo<T>::elemType;
+	static constexpr size_t elemSize = ElemTypeInfo<T>::elemSize;
+	static T infinity() { return ElemTypeInfo<T>::infinity(); }
+	static T floor(T n) { return ElemTypeInfo<T>::floor(n); }
+	static T mod(T n, T d) { return ElemTypeInfo<T>::mod(n, d); }
+	static IImplementation<T>* newImplementation() { return new CpuHalfImplementation<T>(); }
+	static const IImplementation<T>* implementation() { return NULL; }
+};
+
+}
+
+#endif /* UKOCT_CPU_HALF_STATE_HPP_ */
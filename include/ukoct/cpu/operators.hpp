@@ -16,11 +16,13 @@
 #include "ukoct/cpu/operators/isTop.hpp"
 
 #include "ukoct/cpu/operators/shortestPath.hpp"
+#include "ukoct/cpu/operators/blockedShortestPath.hpp"
 #include "ukoct/cpu/operators/strengthen.hpp"
 #include "ukoct/cpu/operators/tighten.hpp"
 #include "ukoct/cpu/operators/top.hpp"
 
 #include "ukoct/cpu/operators/closure.hpp"
+#include "ukoct/cpu/operators/fusedClosure.hpp"
 #include "ukoct/cpu/operators/tightClosure.hpp"
 #include "ukoct/cpu/operators/includes.hpp"
 #include "ukoct/cpu/operators/equals.hpp"
@@ -28,9 +30,15 @@
 
 #include "ukoct/cpu/operators/union.hpp"
 #include "ukoct/cpu/operators/intersection.hpp"
+#include "ukoct/cpu/operators/widening.hpp"
+#include "ukoct/cpu/operators/narrowing.hpp"
 #include "ukoct/cpu/operators/pushDiffCons.hpp"
 #include "ukoct/cpu/operators/pushOctCons.hpp"
 #include "ukoct/cpu/operators/forgetOctVar.hpp"
+#include "ukoct/cpu/operators/incClosure.hpp"
+#include "ukoct/cpu/operators/removeDims.hpp"
+#include "ukoct/cpu/operators/addDims.hpp"
+#include "ukoct/cpu/operators/permuteDims.hpp"
 
 
 #endif /* UKOCT_CPU_OPERATORS_HPP_ */
@@ -1,10 +1,16 @@
 #ifndef UKOCT_CPU_OPERATORS_ABSTRACT_HPP_
 #define UKOCT_CPU_OPERATORS_ABSTRACT_HPP_
 
+#include <algorithm>
 #include <vector>
 
 #include "ukoct/core/defs.hpp"
 #include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/flags.hpp"
+#include "ukoct/cpu/pool.hpp"
+#include "ukoct/cpu/simd.hpp"
+#include "ukoct/cpu/sparse.hpp"
+#include "ukoct/cpu/view.hpp"
 
 namespace ukoct {
 namespace impl {
@@ -40,28 +46,214 @@ public:
 	}
 
 
-	void run(OperatorArgs<T>& args) const {
+	/**
+	 * Runs the operator on its own, as opposed to within another operator.
+	 * Full matrix states keep flags of their known properties, which are
+	 * looked up before running, and updated afterwards. They are prepared
+	 * (see prepare()) only when actually run.
+	 */
+	void run(const OperatorArgs<T>& args) {
+		CpuState<T>* state = dynamic_cast<CpuState<T>*>(&args.state());
+
+		if (state != NULL && cached(args, state->flags(), _result)) {
+			CpuTiming timing;
+			start(timing);
+			end(timing);
+			return;
+		}
+
+		if (state != NULL)
+			prepare(args, *state);
+
 		run(args, _result);
+
+		if (state != NULL)
+			updateFlags(args, state->flags(), _result);
 	}
 
 
 	virtual void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const = 0;
 
 
+	/** Sets ret and returns true when the result is known from the state's flags alone. */
+	virtual bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		return false;
+	}
+
+
+	/**
+	 * Called before running on a full matrix state. By default, mutators get
+	 * a matrix buffer of their own, as it may be shared with copies of the
+	 * state (see CpuState::detach()).
+	 */
+	virtual void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {
+		if (this->details().impl() & O_IMPL_MUTATOR)
+			state.detach();
+	}
+
+
+	/** Updates the state's flags after a run. By default, mutators forget all of them. */
+	virtual void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		if (this->details().impl() & O_IMPL_MUTATOR)
+			flags.forget();
+	}
+
+
 protected:
-	void start(CpuTiming& timing) {
-		_result.timing.start();
+	/**
+	 * The state an O_IMPL_DEST operator writes its result to, made ready to
+	 * be written: args.state() or another operand (args.other() or one of
+	 * args.others()) are detached (see CpuState::detach()) when they are the
+	 * destination, and any other destination is reshaped like args.state()
+	 * (see CpuState::reshape()).
+	 * The operands' buffers may change, so their raw pointers are to be
+	 * taken afterwards.
+	 */
+	static CpuState<T>& destination(const OperatorArgs<T>& args) {
+		CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+
+		if (args.dest() == NULL || args.dest() == &args.state()) {
+			state.detach();
+			return state;
+		}
+
+		CpuState<T>* dest = dynamic_cast<CpuState<T>*>(args.dest());
+		ukoct::assert(dest != NULL && dest->implementation() == state.implementation(), "Destination must be a state of the same implementation.");
+
+		if (args.dest() == args.other() || std::find(args.others(), args.others() + args.numOthers(), args.dest()) != args.others() + args.numOthers())
+			dest->detach();
+		else
+			dest->reshape(state);
+		return *dest;
+	}
+
+
+	/**
+	 * The operands of an O_IMPL_NARY operator: args.state(), args.other()
+	 * when given, and args.others(), which must all be full matrix states of
+	 * the same implementation and size.
+	 */
+	static std::vector<CpuState<T>*> operands(const OperatorArgs<T>& args) {
+		std::vector<CpuState<T>*> ops;
+		ops.reserve(2 + args.numOthers());
+		ops.push_back(&reinterpret_cast<CpuState<T>&>(args.state()));
+		if (args.other() != NULL)
+			ops.push_back(reinterpret_cast<CpuState<T>*>(args.other()));
+		for (size_t k = 0; k < args.numOthers(); ++k)
+			ops.push_back(reinterpret_cast<CpuState<T>*>(args.others()[k]));
+
+		for (size_t k = 1; k < ops.size(); ++k) {
+			ukoct_ASSERT(ops[k] != NULL && ops[k]->implementation() == ops[0]->implementation(), "All matrices need to be from the same implementation.");
+			if (ops[k]->diffSize() != ops[0]->diffSize())
+				throw Error("Problem sizes cannot be different.");
+		}
+		return ops;
+	}
+
+
+	/** The states in ops, each one once and in their first order. */
+	static std::vector<CpuState<T>*> distinct(const std::vector<CpuState<T>*>& ops) {
+		std::vector<CpuState<T>*> ret;
+		ret.reserve(ops.size());
+		for (size_t k = 0; k < ops.size(); ++k) {
+			if (std::find(ret.begin(), ret.end(), ops[k]) == ret.end())
+				ret.push_back(ops[k]);
+		}
+		return ret;
+	}
+
+
+	/**
+	 * Reduces the operands into dest with an elementwise kernel, in a single
+	 * pass over dest: each block of a row is folded with the same block of
+	 * every operand while it stays in cache, and the rows are split among the
+	 * workers of the implementation's pool. The kernel must be commutative,
+	 * as dest may be one of the operands, which is then folded in first.
+	 * Operands of the other ordering are read through rowOf().
+	 */
+	static void reduce(CpuState<T>& dest, const std::vector<CpuState<T>*>& ops, typename impl::cpu::CpuKernels<T>::Elementwise kernel) {
+		size_t n = dest.diffSize();
+		size_t p = dest.pitch();
+		size_t bs = std::max<size_t>(ukoct_CPU_BLOCKBYTES / (2 * sizeof(T)), 1);
+		T infinity = dest.implementation().infinity();
+		T* mat = dest.input().raw();
+		std::vector<const T*> raws(ops.size());
+		std::vector<char> transposed(ops.size());
+		bool anyTransposed = false;
+		for (size_t k = 0; k < ops.size(); ++k) {
+			raws[k] = ops[k]->input().raw();
+			transposed[k] = ops[k]->rowMajor() != dest.rowMajor();
+			anyTransposed = anyTransposed || transposed[k];
+		}
+		for (size_t k = 1; k < raws.size(); ++k) {
+			if (raws[k] == mat) {
+				std::swap(raws[0], raws[k]);
+				std::swap(transposed[0], transposed[k]);
+				break;
+			}
+		}
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+			std::vector<T> buffer(anyTransposed ? 2 * bs : 0);
+
+			for (size_t i = begin; i < end; ++i) {
+				for (size_t j = 0; j < p; j += bs) {
+					size_t len = std::min(bs, p - j);
+					T* row = mat + i * p + j;
+					const T* first = rowOf(raws[0], transposed[0], n, p, i, j, len, buffer.data(), infinity);
+
+					if (raws.size() == 1) {
+						if (first != row)
+							std::copy(first, first + len, row);
+						continue;
+					}
+
+					kernel(row, first, rowOf(raws[1], transposed[1], n, p, i, j, len, buffer.data() + bs, infinity), len);
+					for (size_t k = 2; k < raws.size(); ++k)
+						kernel(row, row, rowOf(raws[k], transposed[k], n, p, i, j, len, buffer.data(), infinity), len);
+				}
+			}
+		};
+
+		if (dest.cpuImplementation().parallel(n))
+			dest.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+	}
+
+
+	/**
+	 * Elements [j, j + len) of row i of an n x n matrix with rows `p` elements
+	 * apart, as seen in the ordering of the matrix being written. They are
+	 * read in place unless the matrix is of the other ordering (`transposed`),
+	 * in which case they're gathered from its column i into `buffer`, with
+	 * the padding set to infinity.
+	 */
+	static const T* rowOf(const T* raw, bool transposed, size_t n, size_t p, size_t i, size_t j, size_t len, T* buffer, T infinity) {
+		if (!transposed)
+			return raw + i * p + j;
+
+		for (size_t c = j; c < j + len; ++c)
+			buffer[c - j] = c < n ? raw[c * p + i] : infinity;
+		return buffer;
+	}
+
+
+	void start(CpuTiming& timing) const {
+		timing.start();
 	}
 
 
-	void end(CpuTiming& timing) {
+	void end(CpuTiming& timing) const {
 		timing.end();
 		_result.timings.push_back(timing);
 	}
 
 
 protected:
-	CpuResult<T> _result;
+	mutable CpuResult<T> _result;
 };
 
 
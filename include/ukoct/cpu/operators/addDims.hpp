@@ -0,0 +1,83 @@
+#ifndef UKOCT_CPU_OPERATORS_ADDDIMS_HPP_
+#define UKOCT_CPU_OPERATORS_ADDDIMS_HPP_
+
+#include <vector>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_ADDDIMS
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class AddDimsCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef AddDimsCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+/**
+ * Inserts unconstrained variables into the state, at the positions (in the
+ * resulting DBM) given by args.vars(). The existing variables keep their
+ * relative order and fill the remaining positions.
+ *
+ * New variables are related to nothing, so all the known properties of the
+ * state, closures included, carry over to the result.
+ */
+template <typename T> class AddDimsCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+
+		if (args.vars() != NULL && !args.vars()->empty()) {
+			size_t octSize = state.octSize() + args.vars()->size();
+			std::vector<bool> added(octSize, false);
+
+			for (size_t k = 0; k < args.vars()->size(); ++k) {
+				plas::var_t v = (*args.vars())[k];
+				ukoct::assert(v > 0 && static_cast<size_t>(v) <= octSize, "Position out of range, should be in between 1 and the resulting octSize.");
+				ukoct::assert(!added[v - 1], "Positions of new variables must be different.");
+				added[v - 1] = true;
+			}
+
+			std::vector<size_t> to(state.octSize());
+			for (size_t v = 0, next = 0; v < to.size(); ++v, ++next) {
+				while (added[next])
+					++next;
+				to[v] = next;
+			}
+			state.remapVars(to, octSize);
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/* The matrix is rebuilt in a new buffer (see CpuState::remapVars()), there's no need to detach it. */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* All flags stay. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_ADDDIMS_HPP_ */
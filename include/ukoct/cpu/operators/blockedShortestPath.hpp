@@ -0,0 +1,112 @@
+#ifndef UKOCT_CPU_OPERATORS_BLOCKEDSHORTESTPATH_HPP_
+#define UKOCT_CPU_OPERATORS_BLOCKEDSHORTESTPATH_HPP_
+
+#include <cmath>
+#include "ukoct/cpu/operators/abstract.hpp"
+#include "ukoct/cpu/operators/shortestPath.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+/**
+ * Cache-blocked (tiled) variant of ShortestPathCpuOperator.
+ *
+ * The matrix is split into square tiles sized after ukoct_CPU_BLOCKBYTES,
+ * and for each block of pivots, the tiles are relaxed in three phases: first
+ * the diagonal tile, then the tiles on the pivots' row and column, and at
+ * last the remaining ones. Each phase only depends on tiles finished by the
+ * previous one, so every tile is reused from cache for a whole pivot block.
+ *
+ * Pivots are taken one by one instead of in (k, K) pairs; both approaches
+ * converge to the same shortest-path matrix. The raw buffer is always walked
+ * as if it were row-major, because the shortest-path closure of the
+ * transposed matrix is the transpose of the closure.
+ */
+template <typename T> class BlockedShortestPathCpuOperator : public AbstractCpuOperator<T> {
+public:
+	static inline constexpr ukoct::EOperation getOperation() { return OPER_SHORTESTPATH; }
+	static inline constexpr ukoct::OperationDetails getDetails() { return O_EXEC_LOOP | O_DIMS_EXACT | O_MEM_LOCAL | O_IMPL_MUTATOR; }
+
+	ukoct::EOperation operation() const { return getOperation(); }
+	ukoct::OperationDetails details() const { return getDetails(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		size_t pivots = args.iterations() == 0 ? n : std::min(n, 2 * args.iterations());
+		size_t bs = blockSize();
+		ret.boolResult = true;
+
+		for (size_t k0 = 0; k0 < pivots && ret.boolResult; k0 += bs) {
+			size_t k1 = std::min(pivots, k0 + bs);
+
+			// Phase 1: Diagonal tile
+			relaxTile(mat, p, k0, k1, k0, std::min(n, k0 + bs), k0, std::min(n, k0 + bs));
+
+			// Phase 2: Tiles on the pivots' row and column
+			for (size_t b0 = 0; b0 < n; b0 += bs) {
+				if (b0 == k0) continue;
+				size_t b1 = std::min(n, b0 + bs);
+				relaxTile(mat, p, k0, k1, k0, std::min(n, k0 + bs), b0, b1);
+				relaxTile(mat, p, k0, k1, b0, b1, k0, std::min(n, k0 + bs));
+			}
+
+			// Phase 3: Remaining tiles
+			for (size_t i0 = 0; i0 < n; i0 += bs) {
+				if (i0 == k0) continue;
+				for (size_t j0 = 0; j0 < n; j0 += bs) {
+					if (j0 == k0) continue;
+					relaxTile(mat, p, k0, k1, i0, std::min(n, i0 + bs), j0, std::min(n, j0 + bs));
+				}
+			}
+
+			// Stop as soon as a negative cycle shows up on the diagonal
+			for (size_t i = 0; i < n && ret.boolResult; ++i)
+				if (mat[i * p + i] < 0)
+					ret.boolResult = false;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		ShortestPathCpuOperator<T>::updateShortestPathFlags(args, flags, ret);
+	}
+
+
+	static size_t blockSize() {
+		// Three tiles (the one being relaxed, plus a row and a column tile)
+		// must fit in the targeted cache at the same time.
+		size_t bs = static_cast<size_t>(std::sqrt(static_cast<double>(ukoct_CPU_BLOCKBYTES) / (3 * sizeof(T))));
+		bs -= bs % 8;
+		return bs < 8 ? 8 : bs;
+	}
+
+private:
+	static inline void relaxTile(T* mat, size_t pitch, size_t k0, size_t k1, size_t i0, size_t i1, size_t j0, size_t j1) {
+		for (size_t k = k0; k < k1; ++k) {
+			const T* rowk = mat + k * pitch;
+			for (size_t i = i0; i < i1; ++i) {
+				T* rowi = mat + i * pitch;
+				T ik = rowi[k];
+				for (size_t j = j0; j < j1; ++j)
+					rowi[j] = std::min(rowi[j], ElemTypeInfo<T>::add(ik, rowk[j]));
+			}
+		}
+	}
+};
+
+}
+}
+}
+}
+
+#endif /* UKOCT_CPU_OPERATORS_BLOCKEDSHORTESTPATH_HPP_ */
@@ -4,6 +4,7 @@
 #include "ukoct/cpu/operators/abstract.hpp"
 #include "ukoct/cpu/operators/shortestPath.hpp"
 #include "ukoct/cpu/operators/isConsistent.hpp"
+#include "ukoct/cpu/operators/isCoherent.hpp"
 #include "ukoct/cpu/operators/strengthen.hpp"
 
 #define ukoct_OPERCODE ukoct::OPER_CLOSURE
@@ -38,13 +39,75 @@ public:
 		StrengthenCpuOperator<T> strengthen;
 
 		shortestPath.run(args, ret);
-		isConsistent.run(args, ret);
+
+		if (ret.boolResult)
+			isConsistent.run(args, ret);
 
 		if (ret.boolResult)
 			strengthen.run(args, ret);
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		return cachedClosure(args, flags, ret);
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		updateClosureFlags(args, flags, ret);
+	}
+
+
+	/**
+	 * A known inconsistent matrix stays so, and closing a strongly closed one
+	 * leaves it as is, so neither needs to be closed again.
+	 */
+	static bool cachedClosure(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) {
+		if (flags.fails(impl::cpu::CPUSTATE_CONSISTENT))
+			ret.boolResult = false;
+		else if (!args.intBased() && complete(args) && flags.holds(impl::cpu::CPUSTATE_STRONGLYCLOSED))
+			ret.boolResult = true;
+		else
+			return false;
+		return true;
+	}
+
+
+	/**
+	 * A consistent, complete closure gives a strongly closed matrix, as long
+	 * as it's coherent. Coherence is checked if unknown, which only takes
+	 * O(n^2); closure preserves it, and only fails on a negative cycle.
+	 */
+	static void updateClosureFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) {
+		flags.retain(ret.boolResult ? impl::cpu::CPUSTATE_COHERENT : 0);
+
+		if (!ret.boolResult) {
+			flags.set(impl::cpu::CPUSTATE_CONSISTENT, false);
+			return;
+		}
+
+		if (args.intBased() || !complete(args))
+			return;
+
+		if (!flags.known(impl::cpu::CPUSTATE_COHERENT)) {
+			IsCoherentCpuOperator<T> isCoherent;
+			CpuResult<T> coherent;
+			isCoherent.run(args, coherent);
+			flags.set(impl::cpu::CPUSTATE_COHERENT, coherent.boolResult);
+		}
+
+		flags.set(impl::cpu::CPUSTATE_CONSISTENT, true);
+		if (flags.holds(impl::cpu::CPUSTATE_COHERENT))
+			flags.set(impl::cpu::CPUSTATE_CLOSED | impl::cpu::CPUSTATE_STRONGLYCLOSED, true);
+	}
+
+private:
+	/** Whether the closure goes through all pivots. */
+	static bool complete(const OperatorArgs<T>& args) {
+		return args.iterations() == 0 || args.iterations() >= args.state().octSize();
+	}
 };
 
 }
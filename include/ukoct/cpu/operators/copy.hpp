@@ -31,15 +31,24 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
-		ukoct_ASSERT(args.state().implementation() != args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
 		ukoct::CpuState<T>& other = *reinterpret_cast<CpuState<T>*>(args.other());
-		plas::DenseMatrix<T>& mat = state.input();
-		plas::DenseMatrix<T>& oth = other.input();
-		std::copy(oth.raw(), oth.raw() + (state.diffSize() * state.diffSize()), mat.raw());
+		state.share(other);
+		state.partition(false) = other.partition(false);
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {
+		// The matrix is replaced, not written to
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags = reinterpret_cast<CpuState<T>*>(args.other())->flags();
+	}
 };
 
 }
@@ -31,25 +31,26 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		T infinity = state.implementation().infinity();
 		plas::var_t v = plas::normalizeVar(args.var());
 
 		ukoct_ASSERT(v > 0 && v <= state.octSize(), "Variable out of range, should be in between 1 and octSize.");
 
-		plas::var_t min = 2 * v - 1;
-		plas::var_t max = 2 * v;
-
-		// Would be wrong if it wasn't know beforehand that each variable loop
-		// will be run exactly twice.
-		for (plas::var_t i = min; i <= max; ++i) {
-			for (plas::var_t j = min; j <= max; ++j)
-				if (i == j)
-					mat(i, j) = 0;
-				else
-					mat(i, j) = infinity;
+		size_t min = 2 * (v - 1);
+		size_t max = min + 1;
+
+		for (size_t i = min; i <= max; ++i) {
+			for (size_t j = 0; j < state.diffSize(); ++j) {
+				mat(i, j) = i == j ? 0 : infinity;
+				mat(j, i) = i == j ? 0 : infinity;
+			}
 		}
 
+		// The variable is now a component of its own, but components can't
+		// be split, so the partition is rebuilt when next needed.
+		state.partition(false).invalidate();
+
 		AbstractCpuOperator<T>::end(timing);
 	}
 };
@@ -0,0 +1,152 @@
+#ifndef UKOCT_CPU_OPERATORS_FUSEDCLOSURE_HPP_
+#define UKOCT_CPU_OPERATORS_FUSEDCLOSURE_HPP_
+
+#include <atomic>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+#include "ukoct/cpu/operators/closure.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+/**
+ * Single-sweep variant of ClosureCpuOperator.
+ *
+ * Instead of running the shortest path closure, the consistency check and
+ * the strengthening as three passes over the whole matrix, each row is
+ * checked for a negative diagonal right after it's relaxed through a pivot
+ * pair, stopping as soon as one is found, and strengthened right after
+ * being relaxed through the last pair. Strengthening once after the last
+ * pivot suffices, as shown by Bagnara, Hill and Zaffanella; the unary
+ * bounds m[Jj] it needs are computed ahead of the last sweep from the pivot
+ * rows alone.
+ *
+ * Results are the same as ClosureCpuOperator's when consistent. When not,
+ * the matrix is left partially closed. Int-based closures are delegated to
+ * ClosureCpuOperator.
+ */
+template <typename T> class FusedClosureCpuOperator : public AbstractCpuOperator<T> {
+public:
+	static inline constexpr ukoct::EOperation getOperation() { return OPER_CLOSURE; }
+	static inline constexpr ukoct::OperationDetails getDetails() { return O_EXEC_ONEPASS | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+
+	ukoct::EOperation operation() const { return getOperation(); }
+	ukoct::OperationDetails details() const { return getDetails(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		size_t iters = args.iterations();
+
+		if (iters == 0 || iters > state.octSize())
+			iters = state.octSize();
+
+		if (args.intBased()) {
+			ClosureCpuOperator<T> closure;
+			closure.run(args, ret);
+
+		} else {
+			ret.boolResult = runFused(state, 2 * iters);
+
+			// Strengthening relates all variables with finite unary bounds
+			if (ret.boolResult)
+				state.partition(false).mergeBounded(state.input().raw(), state.pitch(), state.implementation().infinity());
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		return ClosureCpuOperator<T>::cachedClosure(args, flags, ret);
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		ClosureCpuOperator<T>::updateClosureFlags(args, flags, ret);
+	}
+
+private:
+	/*
+	 * Works as ShortestPathCpuOperator::runParallel, on the raw buffer as if
+	 * it were row-major (closure and strengthening both commute with
+	 * transposition). Before the last sweep, the first worker also gathers
+	 * the unary bounds d[j] = m[Jj] as they will be once relaxed.
+	 */
+	bool runFused(CpuState<T>& state, size_t pivots) const {
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		bool parallel = state.cpuImplementation().parallel(state.diffSize());
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		std::vector<T> pivotRows(2 * n);
+		std::vector<T> d(n);
+		T* rk = &pivotRows[0];
+		T* rK = &pivotRows[n];
+		impl::cpu::CpuPivotIndex<T> index(n, state.implementation().infinity());
+		std::atomic<bool> consistent(true);
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+
+			for (size_t k = 0; k < pivots && consistent; k += 2) {
+				size_t K = k + 1;
+				bool last = k + 2 >= pivots;
+
+				if (worker == 0) {
+					ShortestPathCpuOperator<T>::copyPivots(mat, n, p, k, rk, rK);
+					index.build(rk, rK, n);
+
+					if (last) for (size_t j = 0; j < n; ++j) {
+						const T* row = mat + (j ^ 1) * p;
+						T ik = std::min(row[k], ElemTypeInfo<T>::add(row[K], rK[k]));
+						T iK = std::min(row[K], ElemTypeInfo<T>::add(row[k], rk[K]));
+						d[j] = std::min(row[j], std::min(ElemTypeInfo<T>::add(ik, rk[j]), ElemTypeInfo<T>::add(iK, rK[j])));
+					}
+				}
+
+				if (numWorkers > 1)
+					state.cpuImplementation().pool()->barrier().wait();
+
+				for (size_t i = begin; i < end; ++i) {
+					T* row = mat + i * p;
+					T ik = std::min(row[k], ElemTypeInfo<T>::add(row[K], rK[k]));
+					T iK = std::min(row[K], ElemTypeInfo<T>::add(row[k], rk[K]));
+					index.relax(row, rk, rK, ik, iK, n);
+
+					if (row[i] < 0) {
+						consistent = false;
+						break;
+					}
+
+					if (last) {
+						row[i] = 0;
+						kernels.strengthen(row, &d[0], d[i ^ 1], n);
+					}
+				}
+
+				if (numWorkers > 1)
+					state.cpuImplementation().pool()->barrier().wait();
+			}
+		};
+
+		if (parallel)
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+
+		return consistent;
+	}
+};
+
+}
+}
+}
+}
+
+#endif /* UKOCT_CPU_OPERATORS_FUSEDCLOSURE_HPP_ */
@@ -0,0 +1,155 @@
+#ifndef UKOCT_CPU_OPERATORS_INCCLOSURE_HPP_
+#define UKOCT_CPU_OPERATORS_INCCLOSURE_HPP_
+
+#include "ukoct/cpu/operators/abstract.hpp"
+#include "ukoct/cpu/operators/closure.hpp"
+#include "ukoct/cpu/operators/isConsistent.hpp"
+#include "ukoct/cpu/operators/isIntConsistent.hpp"
+#include "ukoct/cpu/operators/strengthen.hpp"
+#include "ukoct/cpu/operators/tighten.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_INCCLOSURE
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class IncClosureCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef IncClosureCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+
+/**
+ * Pushes a constraint to an already closed DBM and restores its closure in
+ * O(n^2), instead of running a full closure afterwards.
+ *
+ * The octagonal constraint is used if valid, otherwise the difference
+ * constraint is. Either way, the coherent counterpart of each difference
+ * constraint is pushed along with it. The result is the same a full closure
+ * (or tight closure, if int-based) would give, including the consistency
+ * check in boolResult.
+ */
+template <typename T> class IncClosureCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		plas::OctConstraint<T> f = args.octCons();
+		plas::OctDiffConstraint<T> ca = args.diffCons();
+		plas::OctDiffConstraint<T> cb;
+
+		if (f.valid())
+			f.split(ca, cb);
+
+		ukoct_ASSERT(ca.valid(), "A constraint must be provided for this operator.");
+		push(state, ca);
+
+		// The second constraint is usually the coherent counterpart of the
+		// first one, which has already been pushed along with it.
+		if (cb.valid() && (cb.a() != ca.B() || cb.b() != ca.A() || cb.d() != ca.d()))
+			push(state, cb);
+
+		state.partition(false).merge((ca.a() - 1) / 2, (ca.b() - 1) / 2);
+		if (cb.valid())
+			state.partition(false).merge((cb.a() - 1) / 2, (cb.b() - 1) / 2);
+
+		IsConsistentCpuOperator<T> isConsistent;
+		isConsistent.run(args, ret);
+
+		if (ret.boolResult) {
+			if (args.intBased()) {
+				TightenCpuOperator<T> tighten;
+				IsIntConsistentCpuOperator<T> isIntConsistent;
+				tighten.run(args, ret);
+				isIntConsistent.run(args, ret);
+
+			} else {
+				StrengthenCpuOperator<T> strengthen;
+				strengthen.run(args, ret);
+			}
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/** Restores the closure of closed matrices only, and otherwise fails on negative cycles. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		if (!args.intBased() && flags.holds(impl::cpu::CPUSTATE_STRONGLYCLOSED)) {
+			ClosureCpuOperator<T>::updateClosureFlags(args, flags, ret);
+
+		} else {
+			flags.forget();
+			if (!ret.boolResult && !args.intBased())
+				flags.set(impl::cpu::CPUSTATE_CONSISTENT, false);
+		}
+	}
+
+private:
+	/*
+	 * Adds the edges a -> b and B -> A, with weight d. Any shortest path uses
+	 * each new edge at most once, so it suffices to consider reaching b
+	 * either through a -> b or B -> A -> a -> b (and conversely for A), which
+	 * amounts to relaxing every row with the rows b and A as a pivot pair.
+	 * Operates on the raw buffer as if it were row-major, so the constraint
+	 * is transposed for column-major matrices.
+	 */
+	static void push(CpuState<T>& state, const plas::OctDiffConstraint<T>& c) {
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		size_t a = c.a() - 1;
+		size_t b = c.b() - 1;
+		T d = c.d();
+
+		if (!state.rowMajor())
+			std::swap(a, b);
+
+		size_t A = a ^ 1;
+		size_t B = b ^ 1;
+		std::vector<T> pivotRows(2 * n);
+		T* rb = &pivotRows[0];
+		T* rA = &pivotRows[n];
+		std::copy(mat + b * p, mat + b * p + n, rb);
+		std::copy(mat + A * p, mat + A * p + n, rA);
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+
+			for (size_t i = begin; i < end; ++i) {
+				T* row = mat + i * p;
+				T ib = ElemTypeInfo<T>::add(std::min(row[a], ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(row[B], d), rA[a])), d); // i -> a -> b, or i -> B -> A -> a -> b
+				T iA = ElemTypeInfo<T>::add(std::min(row[B], ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(row[a], d), rb[B])), d); // i -> B -> A, or i -> a -> b -> B -> A
+				kernels.relaxPair(row, rb, rA, ib, iA, n);
+			}
+		};
+
+		if (state.cpuImplementation().parallel(n))
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_INCCLOSURE_HPP_ */
@@ -31,25 +31,50 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
-		ukoct_ASSERT(args.state().implementation() != args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
 		ukoct::CpuState<T>& other = *reinterpret_cast<CpuState<T>*>(args.other());
-		plas::DenseMatrix<T>& mat = state.input();
-		plas::DenseMatrix<T>& oth = other.input();
-		ret.boolResult = true;
+		size_t n = state.diffSize();
+
+		// Both views are transposed whenever this matrix is column-major
+		if (&state == &other)
+			ret.boolResult = true;
+		else if (n != other.diffSize())
+			ret.boolResult = false;
+		else if (state.rowMajor() == other.rowMajor())
+			ret.boolResult = sameOrdering(state, other);
+		else
+			ret.boolResult = check(state.view(), impl::cpu::CpuMatrixView<T, plas::MATRIX_COLMAJOR>(other.input().raw(), n, other.pitch()));
 
-		if (&state != &other) {
-			if (state.diffSize() != other.diffSize())
-				ret.boolResult = false;
-				//throw Error("Problem sizes cannot be different.");
+		AbstractCpuOperator<T>::end(timing);
+	}
 
-			for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i)
-				for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j)
-					if (oth(i, j) > mat(i, j))
-						ret.boolResult = false;
-		}
+private:
+	/** Whether o[ij] <= m[ij] for all i and j, row by row up to the first failure, for matrices of the same ordering. */
+	static bool sameOrdering(CpuState<T>& state, CpuState<T>& other) {
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		const T* mat = state.input().raw();
+		const T* oth = other.input().raw();
+		size_t n = state.diffSize();
+
+		// Copies share their buffer until either is mutated
+		if (mat == oth)
+			return true;
+
+		for (size_t i = 0; i < n; ++i)
+			if (!kernels.lessEqual(oth + i * other.pitch(), mat + i * state.pitch(), n))
+				return false;
+		return true;
+	}
 
-		AbstractCpuOperator<T>::end(timing);
+
+	/** Whether o[ij] <= m[ij] for all i and j. */
+	template <plas::EMatrixOrdering O> static bool check(impl::cpu::CpuMatrixView<T> mat, impl::cpu::CpuMatrixView<T, O> oth) {
+		for (size_t i = 0; i < mat.size(); ++i)
+			for (size_t j = 0; j < mat.size(); ++j)
+				if (oth(i, j) > mat(i, j))
+					return false;
+		return true;
 	}
 };
 
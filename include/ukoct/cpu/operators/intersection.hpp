@@ -17,7 +17,7 @@ template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
 	typedef IntersectionCpuOperator<T> Impl;
 	typedef T Type;
 	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
-	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR | O_IMPL_DEST | O_IMPL_NARY; }
 };
 
 
@@ -30,26 +30,40 @@ public:
 		CpuTiming timing;
 		AbstractCpuOperator<T>::start(timing);
 
-		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
-		ukoct_ASSERT(args.state().implementation() != args.other()->implementation(), "Both matrices need to be from the same implementation.");
-		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		ukoct::CpuState<T>& other = *reinterpret_cast<CpuState<T>*>(args.other());
-		plas::DenseMatrix<T>& mat = state.input();
-		plas::DenseMatrix<T>& oth = other.input();
+		ukoct_ASSERT(args.other() != NULL || args.numOthers() > 0, "Secondary matrices must be provided for this operator.");
+		// Union and intersection are idempotent, repeated operands are dropped
+		std::vector<ukoct::CpuState<T>*> ops = AbstractCpuOperator<T>::distinct(AbstractCpuOperator<T>::operands(args));
+		ukoct::CpuState<T>& state = *ops[0];
 		ret.boolResult = true;
 
-		if (&state != &other) {
-			if (state.diffSize() != other.diffSize())
-				//ret.boolResult = false;
-				throw Error("Problem sizes cannot be different.");
+		if (ops.size() > 1 || (args.dest() != NULL && args.dest() != &state)) {
+			impl::cpu::CpuStateFlags flags = state.flags();
+			for (size_t k = 1; k < ops.size(); ++k)
+				flags = impl::cpu::CpuStateFlags::ofIntersection(flags, ops[k]->flags());
+			typename std::vector<ukoct::CpuState<T>*>::iterator it = std::find(ops.begin(), ops.end(), args.dest());
+			ukoct::CpuState<T>& first = it != ops.end() ? **it : state;
+			ukoct::CpuState<T>& dest = AbstractCpuOperator<T>::destination(args);
 
-			for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i)
-				for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j)
-					mat(i, j) = std::min(mat(i, j), oth(i, j));
+			AbstractCpuOperator<T>::reduce(dest, ops, impl::cpu::CpuKernels<T>::get().min);
+			if (&dest != &first)
+				dest.partition(false) = first.partition(false);
+			for (size_t k = 0; k < ops.size() && dest.partition(false).valid(); ++k) {
+				if (ops[k] != &first)
+					dest.partition(false).merge(ops[k]->partition());
+			}
+			dest.flags() = flags;
 		}
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	/* The destination is prepared by run(), see AbstractCpuOperator::destination(). */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* run() sets the flags of the destination, the operands' stay. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {}
 };
 
 }
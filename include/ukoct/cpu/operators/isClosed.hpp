@@ -36,17 +36,57 @@ public:
 
 		if (ret.boolResult) {
 			ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-			plas::DenseMatrix<T>& mat = state.input();
+			ret.boolResult = trianglesHold(state);
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		if (flags.known(impl::cpu::CPUSTATE_CLOSED))
+			ret.boolResult = flags.holds(impl::cpu::CPUSTATE_CLOSED);
+		else if (flags.fails(impl::cpu::CPUSTATE_CONSISTENT))
+			ret.boolResult = false;
+		else
+			return false;
+		return true;
+	}
 
-			for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i) {
-				for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j)
-					for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k)
-						if (mat(i, j) > mat(i, k) + mat(k, j))
-							ret.boolResult = false;
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.zeroedDiagonal();
+		flags.set(impl::cpu::CPUSTATE_CLOSED, ret.boolResult);
+		if (ret.boolResult)
+			flags.set(impl::cpu::CPUSTATE_CONSISTENT, true);
+	}
+
+
+	/**
+	 * Checks whether m[ij] <= m[ik] + m[kj] for all i, j and k. Only indices
+	 * within the same component of the state's partition need to be checked,
+	 * since m[ij] is infinite for any others. The check holds for the
+	 * transposed matrix just as well, so the ordering is irrelevant.
+	 */
+	static bool trianglesHold(CpuState<T>& state) {
+		const T* mat = state.input().raw();
+		size_t p = state.pitch();
+		std::vector<std::vector<size_t> > components;
+		state.partition().components(components);
+
+		for (size_t c = 0; c < components.size(); ++c) {
+			const std::vector<size_t>& idx = components[c];
+
+			for (size_t a = 0; a < idx.size(); ++a) {
+				const T* row = mat + idx[a] * p;
+				for (size_t b = 0; b < idx.size(); ++b)
+					for (size_t k = 0; k < idx.size(); ++k)
+						if (row[idx[b]] > ElemTypeInfo<T>::add(row[idx[k]], mat[idx[k] * p + idx[b]]))
+							return false;
 			}
 		}
 
-		AbstractCpuOperator<T>::end(timing);
+		return true;
 	}
 };
 
@@ -31,13 +31,13 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		ret.boolResult = true;
 
-		for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i) {
-			for (plas::var_t j = 1; i <= state.diffSize(); ++j) {
-				plas::var_t I = plas::switchVar(i);
-				plas::var_t J = plas::switchVar(j);
+		for (size_t i = 0; i < state.diffSize() && ret.boolResult; ++i) {
+			for (size_t j = 0; j < state.diffSize() && ret.boolResult; ++j) {
+				size_t I = i ^ 1;
+				size_t J = j ^ 1;
 
 				if (mat(i, j) != mat(J, I))
 					ret.boolResult = false;
@@ -46,6 +46,19 @@ public:
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		if (!flags.known(impl::cpu::CPUSTATE_COHERENT))
+			return false;
+		ret.boolResult = flags.holds(impl::cpu::CPUSTATE_COHERENT);
+		return true;
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.set(impl::cpu::CPUSTATE_COHERENT, ret.boolResult);
+	}
 };
 
 }
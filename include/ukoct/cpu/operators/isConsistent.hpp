@@ -20,10 +20,10 @@ public:
 		CpuTiming timing;
 		AbstractCpuOperator<T>::start(timing);
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		ret.boolResult = true;
 
-		for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k) {
+		for (size_t k = 0; k < state.diffSize() && ret.boolResult; ++k) {
 			if (mat(k, k) < 0)
 				ret.boolResult = false;
 			else
@@ -32,6 +32,20 @@ public:
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		if (!flags.known(impl::cpu::CPUSTATE_CONSISTENT))
+			return false;
+		ret.boolResult = flags.holds(impl::cpu::CPUSTATE_CONSISTENT);
+		return true;
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.zeroedDiagonal();
+		flags.set(impl::cpu::CPUSTATE_CONSISTENT, ret.boolResult);
+	}
 };
 
 
@@ -31,17 +31,27 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		ret.boolResult = true;
 
-		for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k) {
-			plas::var_t K = plas::switchVar(k);
-			if (mat(k, K) + mat(K, k) < 0)
+		for (size_t k = 0; k < state.diffSize() && ret.boolResult; ++k) {
+			size_t K = k ^ 1;
+			if (ElemTypeInfo<T>::add(mat(k, K), mat(K, k)) < 0)
 				ret.boolResult = false;
 		}
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {
+		// Only reads the matrix
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		// Only reads the matrix
+	}
 };
 
 
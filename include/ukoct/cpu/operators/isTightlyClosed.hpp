@@ -2,6 +2,7 @@
 #define UKOCT_CPU_OPERATORS_ISTIGHTLYCLOSED_HPP_
 
 #include "ukoct/cpu/operators/abstract.hpp"
+#include "ukoct/cpu/operators/isClosed.hpp"
 
 #define ukoct_OPERCODE ukoct::OPER_ISTIGHTLYCLOSED
 
@@ -31,11 +32,11 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		ret.boolResult = true;
 
-		for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k) {
-			plas::var_t K = plas::switchVar(k);
+		for (size_t k = 0; k < state.diffSize() && ret.boolResult; ++k) {
+			size_t K = k ^ 1;
 
 			// for all i, m(i, i) = 0
 			if (mat(k, k) < 0)
@@ -44,28 +45,45 @@ public:
 				mat(k, k) = 0;
 
 			// for all i, m(i, I) is even
-			T n = mat(k, K);
-			if (ElemTypeInfo<T>::mod(n, 2) != 0) //
+			if (mat(k, K) != state.implementation().infinity() && ElemTypeInfo<T>::mod(mat(k, K), 2) != 0)
 				ret.boolResult = false;
 		}
 
-		for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i) {
-			for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j) {
-				plas::var_t I = plas::switchVar(i);
-				plas::var_t J = plas::switchVar(j);
+		for (size_t i = 0; i < state.diffSize() && ret.boolResult; ++i) {
+			for (size_t j = 0; j < state.diffSize() && ret.boolResult; ++j) {
+				size_t I = i ^ 1;
+				size_t J = j ^ 1;
 
 				// for all i j, m[ij] <= (m[iI] + m[Jj]) / 2
-				if (mat(i, j) > (mat(i, I) + mat(J, j)) / 2)
+				if (mat(i, j) > ElemTypeInfo<T>::half(ElemTypeInfo<T>::add(mat(i, I), mat(J, j))))
 					ret.boolResult = false;
-
-				for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k)
-					if (mat(i, j) > mat(i, k) + mat(k, j))
-						ret.boolResult = false;
 			}
 		}
 
+		if (ret.boolResult)
+			ret.boolResult = IsClosedCpuOperator<T>::trianglesHold(state);
+
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		if (flags.known(impl::cpu::CPUSTATE_TIGHTLYCLOSED))
+			ret.boolResult = flags.holds(impl::cpu::CPUSTATE_TIGHTLYCLOSED);
+		else if (flags.fails(impl::cpu::CPUSTATE_CONSISTENT) || flags.fails(impl::cpu::CPUSTATE_CLOSED) || flags.fails(impl::cpu::CPUSTATE_STRONGLYCLOSED))
+			ret.boolResult = false;
+		else
+			return false;
+		return true;
+	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.zeroedDiagonal();
+		flags.set(impl::cpu::CPUSTATE_TIGHTLYCLOSED, ret.boolResult);
+		if (ret.boolResult)
+			flags.set(impl::cpu::CPUSTATE_CONSISTENT | impl::cpu::CPUSTATE_CLOSED | impl::cpu::CPUSTATE_STRONGLYCLOSED, true);
+	}
 };
 
 }
@@ -31,12 +31,12 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		T infinity = state.implementation().infinity();
 		ret.boolResult = true;
 
-		for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i)
-			for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j)
+		for (size_t i = 0; i < state.diffSize() && ret.boolResult; ++i)
+			for (size_t j = 0; j < state.diffSize() && ret.boolResult; ++j)
 				if (i != j && mat(i, j) != infinity)
 					ret.boolResult = false;
 
@@ -31,23 +31,23 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		ret.boolResult = true;
 
-		for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k) {
+		for (size_t k = 0; k < state.diffSize() && ret.boolResult; ++k) {
 			if (mat(k, k) < 0)
 				ret.boolResult = false;
 			else
 				mat(k, k) = 0;
 		}
 
-		for (plas::var_t i = 1; i <= state.diffSize() && ret.boolResult; ++i) {
-			for (plas::var_t j = 1; j <= state.diffSize() && ret.boolResult; ++j) {
-				plas::var_t I = plas::switchVar(i);
-				plas::var_t J = plas::switchVar(j);
+		for (size_t i = 0; i < state.diffSize() && ret.boolResult; ++i) {
+			for (size_t j = 0; j < state.diffSize() && ret.boolResult; ++j) {
+				size_t I = i ^ 1;
+				size_t J = j ^ 1;
 
-				for (plas::var_t k = 1; k <= state.diffSize() && ret.boolResult; ++k) {
-					if (mat(i, k) + mat(k, j) < std::min(mat(i, j), (mat(i, I) + mat(J, j)) / 2))
+				for (size_t k = 0; k < state.diffSize() && ret.boolResult; ++k) {
+					if (ElemTypeInfo<T>::add(mat(i, k), mat(k, j)) < std::min(mat(i, j), ElemTypeInfo<T>::half(ElemTypeInfo<T>::add(mat(i, I), mat(J, j)))))
 						ret.boolResult = false;
 				}
 			}
@@ -55,6 +55,11 @@ public:
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.zeroedDiagonal();
+	}
 };
 
 }
@@ -0,0 +1,98 @@
+#ifndef UKOCT_CPU_OPERATORS_NARROWING_HPP_
+#define UKOCT_CPU_OPERATORS_NARROWING_HPP_
+
+#include <vector>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_NARROWING
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class NarrowingCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef NarrowingCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR | O_IMPL_DEST; }
+};
+
+/**
+ * Narrowing of the state by the other matrix, as in Miné's octagon domain:
+ * only the infinite entries of the state are refined, taking o[ij]. As with
+ * widening, the state isn't closed beforehand.
+ */
+template <typename T> class NarrowingCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		ukoct::CpuState<T>& other = *reinterpret_cast<CpuState<T>*>(args.other());
+		ret.boolResult = true;
+
+		if (state.diffSize() != other.diffSize())
+			throw Error("Problem sizes cannot be different.");
+
+		// Narrowing a matrix by itself leaves it as is
+		if (&state != &other || (args.dest() != NULL && args.dest() != &state)) {
+			impl::cpu::CpuStateFlags flags = &state != &other ? impl::cpu::CpuStateFlags::ofNarrowing(state.flags(), other.flags()) : state.flags();
+			ukoct::CpuState<T>& first = args.dest() == &other ? other : state;
+			ukoct::CpuState<T>& second = &first == &state ? other : state;
+			ukoct::CpuState<T>& dest = AbstractCpuOperator<T>::destination(args);
+			T inf = state.implementation().infinity();
+			T* mat = dest.input().raw();
+			bool transposedA = state.rowMajor() != dest.rowMajor();
+			bool transposedB = other.rowMajor() != dest.rowMajor();
+			size_t n = dest.diffSize();
+			size_t p = dest.pitch();
+
+			// The whole matrix at once, or row by row when an operand is of the other ordering
+			size_t rows = transposedA || transposedB ? n : 1;
+			size_t len = rows == 1 ? n * p : p;
+			std::vector<T> buffer(rows == 1 ? 0 : 2 * p);
+			for (size_t i = 0; i < rows; ++i) {
+				const T* a = AbstractCpuOperator<T>::rowOf(state.input().raw(), transposedA, n, p, i, 0, len, buffer.data(), inf);
+				const T* b = AbstractCpuOperator<T>::rowOf(other.input().raw(), transposedB, n, p, i, 0, len, buffer.data() + p, inf);
+				impl::cpu::CpuKernels<T>::get().narrow(mat + i * p, a, b, inf, len);
+			}
+
+			// Finite entries come from either matrix
+			if (&dest != &first)
+				dest.partition(false) = first.partition(false);
+			if (dest.partition(false).valid())
+				dest.partition(false).merge(second.partition());
+			dest.flags() = flags;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/* The destination is prepared by run(), see AbstractCpuOperator::destination(). */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* run() sets the flags of the destination, the operands' stay. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_NARROWING_HPP_ */
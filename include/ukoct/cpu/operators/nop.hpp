@@ -13,7 +13,7 @@ public:
 	ukoct::EOperation operation() const { return OPER_NONE; }
 	ukoct::OperationDetails details() const { return 0; }
 
-	void run(const OperatorArgs<T>& args) {
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
 		CpuTiming timing;
 		AbstractCpuOperator<T>::start(timing);
 		AbstractCpuOperator<T>::end(timing);
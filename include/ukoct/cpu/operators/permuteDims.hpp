@@ -0,0 +1,80 @@
+#ifndef UKOCT_CPU_OPERATORS_PERMUTEDIMS_HPP_
+#define UKOCT_CPU_OPERATORS_PERMUTEDIMS_HPP_
+
+#include <vector>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_PERMUTEDIMS
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class PermuteDimsCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef PermuteDimsCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+/**
+ * Reorders the variables of the state: variable v + 1 moves to position
+ * (*args.vars())[v], which must be a permutation of 1 to octSize. All the
+ * known properties of the state carry over to the result.
+ */
+template <typename T> class PermuteDimsCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		size_t octSize = state.octSize();
+
+		if (args.vars() != NULL) {
+			ukoct::assert(args.vars()->size() == octSize, "A position must be given for each variable.");
+			std::vector<size_t> to(octSize);
+			std::vector<bool> taken(octSize, false);
+			bool identity = true;
+
+			for (size_t v = 0; v < octSize; ++v) {
+				plas::var_t p = (*args.vars())[v];
+				ukoct::assert(p > 0 && static_cast<size_t>(p) <= octSize, "Position out of range, should be in between 1 and octSize.");
+				ukoct::assert(!taken[p - 1], "Positions must be a permutation.");
+				taken[p - 1] = true;
+				to[v] = p - 1;
+				identity = identity && to[v] == v;
+			}
+
+			if (!identity)
+				state.remapVars(to, octSize);
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/* The matrix is rebuilt in a new buffer (see CpuState::remapVars()), there's no need to detach it. */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* All flags stay. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_PERMUTEDIMS_HPP_ */
@@ -32,15 +32,30 @@ public:
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
 		plas::OctDiffConstraint<T> f = args.diffCons();
-		plas::DenseMatrix<T>& mat = state.input();
+		T* raw = state.input().raw();
+		size_t n = state.diffSize();
+		ret.boolResult = true;
 
-		for (plas::var_t i = 1; i <= state.diffSize() && ret->boolResult(); ++i) {
-			for (plas::var_t j = 1; j <= state.diffSize() && ret->boolResult(); ++j)
-				mat(i, j) = std::min(mat(i, j), mat(i, f.a()) + f.d() + mat(f.b(), j));
-		}
+		if (state.rowMajor())
+			push(impl::cpu::CpuMatrixView<T, plas::MATRIX_ROWMAJOR>(raw, n, state.pitch()), f);
+		else
+			push(impl::cpu::CpuMatrixView<T, plas::MATRIX_COLMAJOR>(raw, n, state.pitch()), f);
+
+		state.partition(false).merge((f.a() - 1) / 2, (f.b() - 1) / 2);
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+private:
+	/** m[ij] = min(m[ij], m[ia] + d + m[bj]), in place. */
+	template <plas::EMatrixOrdering O> static void push(impl::cpu::CpuMatrixView<T, O> mat, const plas::OctDiffConstraint<T>& f) {
+		size_t a = f.a() - 1;
+		size_t b = f.b() - 1;
+
+		for (size_t i = 0; i < mat.size(); ++i)
+			for (size_t j = 0; j < mat.size(); ++j)
+				mat(i, j) = std::min(mat(i, j), ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(mat(i, a), f.d()), mat(b, j)));
+	}
 };
 
 }
@@ -32,20 +32,38 @@ public:
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
 		plas::OctDiffConstraint<T> ca, cb;
-		plas::DenseMatrix<T>& mat = state.input();
+		T* raw = state.input().raw();
+		size_t n = state.diffSize();
 		args.octCons().split(ca, cb);
 
-		for (plas::var_t i = 1; i < state.diffSize(); ++i) {
-			for (plas::var_t j = 1; j < state.diffSize(); ++j) {
-				T da = mat(i, ca.a()) + ca.d() + mat(ca.b(), j);
-				T db = da;
-				if (cb.valid())
-					db = mat(i, cb.a()) + cb.d() + mat(cb.b(), j);
+		if (state.rowMajor())
+			push(impl::cpu::CpuMatrixView<T, plas::MATRIX_ROWMAJOR>(raw, n, state.pitch()), ca, cb);
+		else
+			push(impl::cpu::CpuMatrixView<T, plas::MATRIX_COLMAJOR>(raw, n, state.pitch()), ca, cb);
+
+		state.partition(false).merge((ca.a() - 1) / 2, (ca.b() - 1) / 2);
+		if (cb.valid())
+			state.partition(false).merge((cb.a() - 1) / 2, (cb.b() - 1) / 2);
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+private:
+	/** m[ij] = min(m[ij], m[ia] + d + m[bj]) for both constraints at once, in place. */
+	template <plas::EMatrixOrdering O> static void push(impl::cpu::CpuMatrixView<T, O> mat, plas::OctDiffConstraint<T> ca, plas::OctDiffConstraint<T> cb) {
+		size_t aa = ca.a() - 1;
+		size_t ab = ca.b() - 1;
+		size_t ba = cb.valid() ? cb.a() - 1 : aa;
+		size_t bb = cb.valid() ? cb.b() - 1 : ab;
+		T bd = cb.valid() ? cb.d() : ca.d();
+
+		for (size_t i = 0; i < mat.size(); ++i) {
+			for (size_t j = 0; j < mat.size(); ++j) {
+				T da = ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(mat(i, aa), ca.d()), mat(ab, j));
+				T db = ElemTypeInfo<T>::add(ElemTypeInfo<T>::add(mat(i, ba), bd), mat(bb, j));
 				mat(i, j) = std::min(mat(i, j), std::min(da, db));
 			}
 		}
-
-		AbstractCpuOperator<T>::end(timing);
 	}
 };
 
@@ -0,0 +1,94 @@
+#ifndef UKOCT_CPU_OPERATORS_REMOVEDIMS_HPP_
+#define UKOCT_CPU_OPERATORS_REMOVEDIMS_HPP_
+
+#include <limits>
+#include <vector>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_REMOVEDIMS
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class RemoveDimsCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef RemoveDimsCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR; }
+};
+
+/**
+ * Projects the state onto the variables not in args.vars(), which are taken
+ * out of the matrix, the others keeping their relative order. Unlike
+ * forgetting them (see ForgetOctVarCpuOperator), the matrix shrinks, and so
+ * does the cost of later operations.
+ *
+ * The remaining entries are kept as they are, so the result is closed (in
+ * any of the senses) if the state was, as paths through removed variables
+ * are already accounted for. It should be closed beforehand, or the
+ * constraints the removed variables induce on the others are lost.
+ */
+template <typename T> class RemoveDimsCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		size_t octSize = state.octSize();
+		std::vector<bool> removed(octSize, false);
+		size_t numRemoved = 0;
+
+		if (args.vars() != NULL) {
+			for (size_t k = 0; k < args.vars()->size(); ++k) {
+				plas::var_t v = plas::normalizeVar((*args.vars())[k]);
+				ukoct::assert(v > 0 && static_cast<size_t>(v) <= octSize, "Variable out of range, should be in between 1 and octSize.");
+				if (!removed[v - 1]) {
+					removed[v - 1] = true;
+					++numRemoved;
+				}
+			}
+		}
+
+		if (numRemoved == octSize)
+			throw Error("Cannot remove all the variables of a DBM.");
+
+		if (numRemoved > 0) {
+			std::vector<size_t> to(octSize);
+			size_t next = 0;
+			for (size_t v = 0; v < octSize; ++v)
+				to[v] = removed[v] ? std::numeric_limits<size_t>::max() : next++;
+			state.remapVars(to, next);
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/* The matrix is rebuilt in a new buffer (see CpuState::remapVars()), there's no need to detach it. */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* Properties known to hold are kept, those known to fail may not anymore. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.retain(CPUSTATE_ALL);
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_REMOVEDIMS_HPP_ */
@@ -1,6 +1,8 @@
 #ifndef UKOCT_CPU_OPERATORS_SHORTESTPATH_HPP_
 #define UKOCT_CPU_OPERATORS_SHORTESTPATH_HPP_
 
+#include <atomic>
+
 #include "ukoct/cpu/operators/abstract.hpp"
 
 #define ukoct_OPERCODE ukoct::OPER_SHORTESTPATH
@@ -30,42 +32,187 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		size_t n = state.diffSize();
 		size_t iters = args.iterations();
+		bool parallel = state.cpuImplementation().parallel(n);
+		std::vector<std::vector<size_t> > components;
 
-		if (iters == 0)
-			iters = state.diffSize();
-
-		if (iters > state.diffSize() / 2)
-			iters = state.diffSize() / 2;
-
-		for (size_t k = 1; k <= iters; ++k, ++k) {
-			plas::var_t K = plas::switchVar(k);
-
-			for (plas::var_t i = 1; i <= state.diffSize(); ++i)
-				for (plas::var_t j = 1; j <= state.diffSize(); ++j) {
-					plas::var_t I = plas::switchVar(i);
-					plas::var_t J = plas::switchVar(j);
-					mat(i, j) = std::min(
-						mat(i, j), std::min(                            // i -> j
-							mat(i, k) + mat(k, j), std::min(            // i -> k -> j
-								mat(i, K) + mat(K, j), std::min(        // i -> K -> j
-									mat(i, k) + mat(k, K) + mat(K, j),  // i -> k -> K -> j
-									mat(i, K) + mat(K, k) + mat(k, j)   // i -> K -> k -> j
-								)
-							)
-						)
-					);
-				}
+		if (iters == 0 || iters > state.octSize())
+			iters = state.octSize();
+
+		// Partial closures follow the global pivot order, so they can't be split
+		if (iters == state.octSize())
+			state.partition().components(components);
+
+		// boolResult is false when a negative cycle is found, in which case
+		// the closure stops right away, leaving the matrix partially closed.
+		if (components.size() > 1 && !(parallel && 2 * components[0].size() > n)) {
+			ret.boolResult = runComponents(state, components);
+
+		} else if (parallel) {
+			ret.boolResult = runParallel(state, 2 * iters);
 
-			// QUESTION: Is it needed to strengthen right after shortest path, as in miné's paper,
-			// or can it be left to closure?
-			// ANSWER: YES.
-			// TODO strengthen here.
+		} else {
+			ret.boolResult = runSequential(state.input().raw(), n, state.pitch(), 2 * iters, state.implementation().infinity());
 		}
 
+		// Strengthening is left to ClosureCpuOperator, or done within the
+		// pivot loop by FusedClosureCpuOperator.
+
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		updateShortestPathFlags(args, flags, ret);
+	}
+
+
+	/** Shortest path closure preserves coherence, and only fails on a negative cycle. */
+	static void updateShortestPathFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) {
+		flags.retain(impl::cpu::CPUSTATE_COHERENT);
+		if (!ret.boolResult)
+			flags.set(impl::cpu::CPUSTATE_CONSISTENT, false);
+	}
+
+private:
+	/*
+	 * Relaxes rows [begin, end) through the pivot pair (k, K = k + 1), given
+	 * copies of both pivot rows. Every path through {k, K} is considered:
+	 *   min(i -> j, i -> k -> j, i -> K -> j, i -> k -> K -> j, i -> K -> k -> j)
+	 * by first reducing the paths from i into the pair. Working on copies
+	 * makes this exact even while the pivot rows themselves are updated.
+	 * Operates on the raw buffer as if it were row-major, since the closure
+	 * of a transposed matrix is the transpose of its closure. Rows which
+	 * cannot reach the pivots are skipped, and only the pivots' finite
+	 * columns are visited when they are sparse. Returns false as soon as a
+	 * row's diagonal turns negative, which is then bound to stay negative.
+	 * Rows are `pitch` elements apart.
+	 */
+	static bool relaxRows(T* mat, size_t n, size_t pitch, size_t begin, size_t end, size_t k, const T* rk, const T* rK, const impl::cpu::CpuPivotIndex<T>& pivots) {
+		size_t K = k + 1;
+
+		for (size_t i = begin; i < end; ++i) {
+			T* row = mat + i * pitch;
+			T ik = std::min(row[k], ElemTypeInfo<T>::add(row[K], rK[k])); // i -> k, or i -> K -> k
+			T iK = std::min(row[K], ElemTypeInfo<T>::add(row[k], rk[K])); // i -> K, or i -> k -> K
+			pivots.relax(row, rk, rK, ik, iK, n);
+
+			if (row[i] < 0)
+				return false;
+		}
+
+		return true;
+	}
+
+
+	static bool runSequential(T* mat, size_t n, size_t pitch, size_t pivots, T infinity) {
+		std::vector<T> pivotRows(2 * n);
+		T* rk = &pivotRows[0];
+		T* rK = &pivotRows[n];
+		impl::cpu::CpuPivotIndex<T> index(n, infinity);
+
+		for (size_t k = 0; k < pivots; k += 2) {
+			copyPivots(mat, n, pitch, k, rk, rK);
+			index.build(rk, rK, n);
+			if (!relaxRows(mat, n, pitch, 0, n, k, rk, rK, index))
+				return false;
+		}
+
+		return true;
+	}
+
+
+	/*
+	 * No path leaves a component of the state's partition, so each one is
+	 * closed on its own, after being gathered into a compact matrix. Pivots
+	 * are still taken in ascending order, so the results are the same as the
+	 * global closure's. Components are distributed amongst the pool's
+	 * workers, largest first. No more components are taken once one of them
+	 * is found inconsistent.
+	 */
+	bool runComponents(CpuState<T>& state, const std::vector<std::vector<size_t> >& components) const {
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		T infinity = state.implementation().infinity();
+		std::atomic<size_t> next(0);
+		std::atomic<bool> consistent(true);
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			std::vector<T> sub;
+
+			for (size_t c = next++; c < components.size() && consistent; c = next++) {
+				const std::vector<size_t>& idx = components[c];
+				size_t m = idx.size();
+				sub.resize(m * m);
+
+				for (size_t a = 0; a < m; ++a)
+					for (size_t b = 0; b < m; ++b)
+						sub[a * m + b] = mat[idx[a] * p + idx[b]];
+
+				if (!runSequential(&sub[0], m, m, m, infinity))
+					consistent = false;
+
+				for (size_t a = 0; a < m; ++a)
+					for (size_t b = 0; b < m; ++b)
+						mat[idx[a] * p + idx[b]] = sub[a * m + b];
+			}
+		};
+
+		if (state.cpuImplementation().parallel(n))
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+
+		return consistent;
+	}
+
+
+	/*
+	 * Rows are split amongst the pool's workers, and the pivot rows are
+	 * copied and indexed by the first worker before each pair is relaxed.
+	 * The consistency flag is only read between the two barriers, so all
+	 * workers agree on when to stop.
+	 */
+	bool runParallel(CpuState<T>& state, size_t pivots) const {
+		impl::cpu::CpuThreadPool& pool = *state.cpuImplementation().pool();
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		std::vector<T> pivotRows(2 * n);
+		T* rk = &pivotRows[0];
+		T* rK = &pivotRows[n];
+		impl::cpu::CpuPivotIndex<T> index(n, state.implementation().infinity());
+		std::atomic<bool> consistent(true);
+
+		pool.run([&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+
+			for (size_t k = 0; k < pivots && consistent; k += 2) {
+				if (worker == 0) {
+					copyPivots(mat, n, p, k, rk, rK);
+					index.build(rk, rK, n);
+				}
+				pool.barrier().wait();
+
+				if (!relaxRows(mat, n, p, begin, end, k, rk, rK, index))
+					consistent = false;
+				pool.barrier().wait();
+			}
+		});
+
+		return consistent;
+	}
+
+
+public:
+	/** Copies the pivot rows k and k + 1 of a matrix with rows `pitch` elements apart. */
+	static inline void copyPivots(const T* mat, size_t n, size_t pitch, size_t k, T* rk, T* rK) {
+		std::copy(mat + k * pitch, mat + k * pitch + n, rk);
+		std::copy(mat + (k + 1) * pitch, mat + (k + 1) * pitch + n, rK);
+	}
 };
 
 }
@@ -30,27 +30,73 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		T* raw = state.input().raw();
+		size_t n = state.diffSize();
 		bool intBased = args.intBased();
 
-		for (plas::var_t i = 1; i <= state.diffSize(); ++i) {
-			for (plas::var_t j = 1; j <= state.diffSize(); ++j) {
-				plas::var_t I = plas::switchVar(i);
-				plas::var_t J = plas::switchVar(j);
-				if (!intBased)
-					mat(i, j) = std::min(mat(i, j), (mat(i, I) + mat(J, j)) / 2);
-
-				else {
-					if (i == j)
-						mat(i, j) = std::min(mat(i, j), std::floor((mat(i, I) + mat(J, j)) / 2));
-					else
-						mat(i, j) = 2 * std::floor(mat(i, I) / 2);
-				}
-			}
-		}
+		if (!intBased)
+			runFloat(state);
+		else if (state.rowMajor())
+			runInt(impl::cpu::CpuMatrixView<T, plas::MATRIX_ROWMAJOR>(raw, n, state.pitch()));
+		else
+			runInt(impl::cpu::CpuMatrixView<T, plas::MATRIX_COLMAJOR>(raw, n, state.pitch()));
+
+		// Strengthening relates all variables with finite unary bounds
+		state.partition(false).mergeBounded(raw, state.pitch(), state.implementation().infinity());
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+private:
+	/*
+	 * The m[iI] entries are never changed by strengthening, so they are
+	 * gathered beforehand into a vector indexed by column (d[j] = m[Jj]),
+	 * after which each row is strengthened independently, in parallel when
+	 * the implementation allows it. Strengthening is also indifferent to the
+	 * matrix's ordering.
+	 */
+	void runFloat(CpuState<T>& state) const {
+		const impl::cpu::CpuKernels<T>& kernels = impl::cpu::CpuKernels<T>::get();
+		T* mat = state.input().raw();
+		size_t n = state.diffSize();
+		size_t p = state.pitch();
+		std::vector<T> d(n);
+
+		for (size_t j = 0; j < n; ++j)
+			d[j] = mat[(j ^ 1) * p + j];
+
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+
+			for (size_t i = begin; i < end; ++i)
+				kernels.strengthen(mat + i * p, &d[0], d[i ^ 1], n);
+		};
+
+		if (state.cpuImplementation().parallel(n))
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
+	}
+
+
+	/*
+	 * Integer strengthening: the m[iI] entries are first tightened to even
+	 * values, then every entry is strengthened with them, their sum halving
+	 * exactly.
+	 */
+	template <plas::EMatrixOrdering O> static void runInt(impl::cpu::CpuMatrixView<T, O> mat) {
+		for (size_t i = 0; i < mat.size(); ++i)
+			mat(i, i ^ 1) = ElemTypeInfo<T>::floorEven(mat(i, i ^ 1));
+
+		for (size_t i = 0; i < mat.size(); ++i) {
+			for (size_t j = 0; j < mat.size(); ++j) {
+				size_t I = i ^ 1;
+				size_t J = j ^ 1;
+				mat(i, j) = std::min(mat(i, j), ElemTypeInfo<T>::floorHalf(ElemTypeInfo<T>::add(mat(i, I), mat(J, j))));
+			}
+		}
+	}
 };
 
 }
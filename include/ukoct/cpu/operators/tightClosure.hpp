@@ -39,7 +39,9 @@ public:
 		TightenCpuOperator<T> tighten;
 
 		shortestPath.run(args, ret);
-		isConsistent.run(args, ret);
+
+		if (ret.boolResult)
+			isConsistent.run(args, ret);
 
 		if (ret.boolResult) {
 			tighten.run(args, ret);
@@ -48,6 +50,25 @@ public:
 
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	bool cached(const OperatorArgs<T>& args, const impl::cpu::CpuStateFlags& flags, CpuResult<T>& ret) const {
+		if (!flags.fails(impl::cpu::CPUSTATE_CONSISTENT))
+			return false;
+		ret.boolResult = false;
+		return true;
+	}
+
+
+	/*
+	 * Tightening doesn't strengthen the matrix, so only consistency (which
+	 * isIntConsistent doesn't tell apart on failure) and coherence are kept.
+	 */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.retain(ret.boolResult ? impl::cpu::CPUSTATE_COHERENT : 0);
+		if (ret.boolResult)
+			flags.set(impl::cpu::CPUSTATE_CONSISTENT, true);
+	}
 };
 
 }
@@ -30,12 +30,21 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
-
-		for (plas::var_t i = 1; i <= state.diffSize(); ++i) {
-			plas::var_t I = plas::switchVar(i);
-			mat(i, I) = 2 * std::floor(mat(i, I) / 2);
-		}
+		impl::cpu::CpuMatrixView<T> mat = state.view();
+		size_t n = state.diffSize();
+
+		// m[iI] and m[Ii] are at mirrored positions, so ordering is irrelevant
+		auto task = [&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			impl::cpu::CpuThreadPool::range(n, worker, numWorkers, begin, end);
+			for (size_t i = begin; i < end; ++i)
+				mat(i, i ^ 1) = ElemTypeInfo<T>::floorEven(mat(i, i ^ 1));
+		};
+
+		if (state.cpuImplementation().parallel(n))
+			state.cpuImplementation().pool()->run(task);
+		else
+			task(0, 1);
 
 		AbstractCpuOperator<T>::end(timing);
 	}
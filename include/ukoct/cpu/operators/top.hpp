@@ -30,19 +30,27 @@ public:
 		AbstractCpuOperator<T>::start(timing);
 
 		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
-		plas::DenseMatrix<T>& mat = state.input();
+		impl::cpu::CpuMatrixView<T> mat = state.view();
 		T infinity = state.implementation().infinity();
 
-		for (plas::var_t i = 1; i <= state.diffSize(); ++i) {
-			for (plas::var_t j = 1; j <= state.diffSize(); ++j)
+		for (size_t i = 0; i < state.diffSize(); ++i) {
+			for (size_t j = 0; j < state.diffSize(); ++j)
 				if (i == j)
 					mat(i, j) = 0;
 				else
 					mat(i, j) = infinity;
 		}
 
+		state.partition(false).reset(state.octSize());
+
 		AbstractCpuOperator<T>::end(timing);
 	}
+
+
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {
+		flags.forget();
+		flags.set(impl::cpu::CPUSTATE_CONSISTENT | impl::cpu::CPUSTATE_COHERENT | impl::cpu::CPUSTATE_CLOSED | impl::cpu::CPUSTATE_STRONGLYCLOSED, true);
+	}
 };
 
 }
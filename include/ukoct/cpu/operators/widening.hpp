@@ -0,0 +1,116 @@
+#ifndef UKOCT_CPU_OPERATORS_WIDENING_HPP_
+#define UKOCT_CPU_OPERATORS_WIDENING_HPP_
+
+#include <algorithm>
+#include <vector>
+
+#include "ukoct/cpu/operators/abstract.hpp"
+
+#define ukoct_OPERCODE ukoct::OPER_WIDENING
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+namespace octdiff {
+
+template <typename T> class WideningCpuOperator;
+
+template <typename T> struct OperationImpl<T, ukoct_OPERCODE> {
+	static constexpr bool valid = true;
+	typedef WideningCpuOperator<T> Impl;
+	typedef T Type;
+	static constexpr ukoct::EOperation operation = ukoct_OPERCODE;
+	static constexpr ukoct::OperationDetails details() { return O_EXEC_LOOP | O_DIMS_EXACT | O_IMPL_MUTATOR | O_IMPL_DEST; }
+};
+
+/**
+ * Widening of the state (the previous iterate) by the other matrix, as in
+ * Miné's octagon domain: m[ij] is kept where o[ij] <= m[ij], and goes to the
+ * first of args.thresholds() not below o[ij], or infinity, elsewhere.
+ *
+ * The state is used as is and isn't closed beforehand, which would break
+ * termination; the other matrix may be closed for precision. The result
+ * is generally not closed.
+ */
+template <typename T> class WideningCpuOperator : public AbstractCpuOperator<T> {
+public:
+	ukoct::EOperation operation() const { return OperationImpl<T, ukoct_OPERCODE>::operation; }
+	ukoct::OperationDetails details() const { return OperationImpl<T, ukoct_OPERCODE>::details(); }
+
+	void run(const OperatorArgs<T>& args, CpuResult<T>& ret) const {
+		CpuTiming timing;
+		AbstractCpuOperator<T>::start(timing);
+
+		ukoct_ASSERT(args.other() != NULL, "Secondary matrix must be provided for this operator.");
+		ukoct_ASSERT(args.state().implementation() == args.other()->implementation(), "Both matrices need to be from the same implementation.");
+		ukoct::CpuState<T>& state = reinterpret_cast<CpuState<T>&>(args.state());
+		ukoct::CpuState<T>& other = *reinterpret_cast<CpuState<T>*>(args.other());
+		ret.boolResult = true;
+
+		if (state.diffSize() != other.diffSize())
+			throw Error("Problem sizes cannot be different.");
+
+		// Widening a matrix by itself leaves it as is
+		if (&state != &other || (args.dest() != NULL && args.dest() != &state)) {
+			impl::cpu::CpuStateFlags flags = &state != &other ? impl::cpu::CpuStateFlags::ofWidening(state.flags(), other.flags()) : state.flags();
+			ukoct::CpuState<T>& dest = AbstractCpuOperator<T>::destination(args);
+			const std::vector<T>* thresholds = args.thresholds();
+			T inf = state.implementation().infinity();
+			T* mat = dest.input().raw();
+			bool transposedA = state.rowMajor() != dest.rowMajor();
+			bool transposedB = other.rowMajor() != dest.rowMajor();
+			size_t n = dest.diffSize();
+			size_t p = dest.pitch();
+
+			// The whole matrix at once, or row by row when an operand is of the other ordering
+			size_t rows = transposedA || transposedB ? n : 1;
+			size_t len = rows == 1 ? n * p : p;
+			std::vector<T> buffer(rows == 1 ? 0 : 2 * p);
+			for (size_t i = 0; i < rows; ++i) {
+				const T* a = AbstractCpuOperator<T>::rowOf(state.input().raw(), transposedA, n, p, i, 0, len, buffer.data(), inf);
+				const T* b = AbstractCpuOperator<T>::rowOf(other.input().raw(), transposedB, n, p, i, 0, len, buffer.data() + p, inf);
+				if (thresholds == NULL || thresholds->empty())
+					impl::cpu::CpuKernels<T>::get().widen(mat + i * p, a, b, inf, len);
+				else
+					widen(mat + i * p, a, b, *thresholds, inf, len);
+			}
+
+			// Entries only stay finite where they were, the partition stays valid (if coarser)
+			if (&dest != &state)
+				dest.partition(false) = state.partition(false);
+			dest.flags() = flags;
+		}
+
+		AbstractCpuOperator<T>::end(timing);
+	}
+
+
+	/* The destination is prepared by run(), see AbstractCpuOperator::destination(). */
+	void prepare(const OperatorArgs<T>& args, CpuState<T>& state) const {}
+
+
+	/* run() sets the flags of the destination, the operands' stay. */
+	void updateFlags(const OperatorArgs<T>& args, impl::cpu::CpuStateFlags& flags, const CpuResult<T>& ret) const {}
+
+private:
+	/** dst[j] = b[j] <= a[j] ? a[j] : the first threshold not below b[j], or inf. */
+	static void widen(T* dst, const T* a, const T* b, const std::vector<T>& thresholds, T inf, size_t n) {
+		for (size_t j = 0; j < n; ++j) {
+			if (b[j] <= a[j]) {
+				dst[j] = a[j];
+			} else {
+				typename std::vector<T>::const_iterator t = std::lower_bound(thresholds.begin(), thresholds.end(), b[j]);
+				dst[j] = t != thresholds.end() ? *t : inf;
+			}
+		}
+	}
+};
+
+}
+}
+}
+}
+
+#undef ukoct_OPERCODE
+
+#endif /* UKOCT_CPU_OPERATORS_WIDENING_HPP_ */
@@ -0,0 +1,180 @@
+#ifndef UKOCT_CPU_PARTITION_HPP_
+#define UKOCT_CPU_PARTITION_HPP_
+
+#include <vector>
+#include <algorithm>
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * A partition of the octagonal variables of a DBM, as a union-find forest.
+ *
+ * Two variables must be in the same component whenever any of the four
+ * entries relating them is finite, so a DBM is block-diagonal with respect
+ * to its partition (up to a permutation). A partition may be coarser than
+ * needed, it is still correct. Variables are 0-based, and variable v covers
+ * the difference indices 2v and 2v + 1.
+ *
+ * A partition can also be unknown (invalid), e.g. after an operation which
+ * could split components. Updates on unknown partitions are ignored; they
+ * must be rebuilt from the matrix before use.
+ */
+class CpuPartition {
+public:
+	CpuPartition() :
+		_parent(),
+		_valid(false) {}
+
+
+	bool valid() const {
+		return _valid;
+	}
+
+
+	void invalidate() {
+		_valid = false;
+	}
+
+
+	size_t size() const {
+		return _parent.size();
+	}
+
+
+	/** Makes every variable a component of its own. */
+	void reset(size_t octSize) {
+		_parent.resize(octSize);
+		for (size_t v = 0; v < octSize; ++v)
+			_parent[v] = v;
+		_valid = true;
+	}
+
+
+	/** Builds the finest partition for a diffSize x diffSize matrix, with rows `pitch` elements apart. */
+	template <typename T> void build(const T* mat, size_t diffSize, size_t pitch, T infinity) {
+		reset(diffSize / 2);
+
+		for (size_t i = 0; i < diffSize; ++i) {
+			const T* row = mat + i * pitch;
+			for (size_t j = 0; j < diffSize; ++j)
+				if (row[j] < infinity)
+					merge(i / 2, j / 2);
+		}
+	}
+
+
+	size_t find(size_t v) {
+		while (_parent[v] != v) {
+			_parent[v] = _parent[_parent[v]];
+			v = _parent[v];
+		}
+		return v;
+	}
+
+
+	void merge(size_t u, size_t v) {
+		if (!_valid)
+			return;
+
+		u = find(u);
+		v = find(v);
+		if (u < v)
+			_parent[v] = u;
+		else if (v < u)
+			_parent[u] = v;
+	}
+
+
+	/** Merges the components of another partition into this one. */
+	void merge(CpuPartition& other) {
+		if (!other.valid() || other.size() != size()) {
+			invalidate();
+			return;
+		}
+
+		for (size_t v = 0; v < size(); ++v)
+			merge(v, other.find(v));
+	}
+
+
+	/**
+	 * Carries the partition over to a DBM of octSize variables, where
+	 * variable v becomes to[v], or is dropped if to[v] >= octSize. Variables
+	 * of the new DBM no old one maps to are components of their own. Dropping
+	 * variables may split components, so the result may be coarser than needed.
+	 */
+	void remap(const std::vector<size_t>& to, size_t octSize) {
+		if (!_valid)
+			return;
+
+		CpuPartition result;
+		std::vector<size_t> first(size(), octSize);
+		result.reset(octSize);
+
+		for (size_t v = 0; v < size(); ++v) {
+			if (to[v] >= octSize)
+				continue;
+			size_t root = find(v);
+			if (first[root] == octSize)
+				first[root] = to[v];
+			else
+				result.merge(first[root], to[v]);
+		}
+
+		std::swap(_parent, result._parent);
+	}
+
+
+	/**
+	 * Merges all variables with a finite unary bound, i.e. m[iI] < infinity.
+	 * Strengthening relates all of them to each other.
+	 */
+	template <typename T> void mergeBounded(const T* mat, size_t pitch, T infinity) {
+		size_t first = size();
+
+		for (size_t v = 0; v < size(); ++v) {
+			size_t i = 2 * v;
+			if (mat[i * pitch + i + 1] < infinity || mat[(i + 1) * pitch + i] < infinity) {
+				if (first == size())
+					first = v;
+				merge(first, v);
+			}
+		}
+	}
+
+
+	/**
+	 * Lists the difference indices of each component, in ascending order,
+	 * with the largest components first.
+	 */
+	void components(std::vector<std::vector<size_t> >& result) {
+		std::vector<size_t> slot(size(), size());
+		result.clear();
+
+		for (size_t v = 0; v < size(); ++v) {
+			size_t root = find(v);
+			if (slot[root] == size()) {
+				slot[root] = result.size();
+				result.push_back(std::vector<size_t>());
+			}
+			result[slot[root]].push_back(2 * v);
+			result[slot[root]].push_back(2 * v + 1);
+		}
+
+		std::stable_sort(result.begin(), result.end(), [](const std::vector<size_t>& a, const std::vector<size_t>& b) {
+			return a.size() > b.size();
+		});
+	}
+
+private:
+	std::vector<size_t> _parent;
+	bool _valid;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_PARTITION_HPP_ */
@@ -0,0 +1,219 @@
+#ifndef UKOCT_CPU_POOL_HPP_
+#define UKOCT_CPU_POOL_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+#include "ukoct/core/defs.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * A reusable barrier for a fixed number of threads.
+ *
+ * Threads calling wait() are blocked until `count` threads have called it,
+ * at which point all of them are released and the barrier resets itself for
+ * the next phase.
+ */
+class CpuBarrier {
+public:
+	explicit CpuBarrier(size_t count) :
+		_count(count),
+		_waiting(0),
+		_generation(0) {}
+
+
+	size_t count() const {
+		return _count;
+	}
+
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(_mutex);
+		size_t generation = _generation;
+
+		if (++_waiting == _count) {
+			_waiting = 0;
+			_generation++;
+			_cond.notify_all();
+
+		} else {
+			while (generation == _generation)
+				_cond.wait(lock);
+		}
+	}
+
+private:
+	CpuBarrier(const CpuBarrier&);
+	CpuBarrier& operator=(const CpuBarrier&);
+
+	std::mutex _mutex;
+	std::condition_variable _cond;
+	size_t _count;
+	size_t _waiting;
+	size_t _generation;
+};
+
+
+/**
+ * A persistent pool of worker threads.
+ *
+ * run() executes the same task on every worker, passing its index and the
+ * total number of workers, and returns only after all of them finished. The
+ * calling thread takes part in the execution as worker 0, so a pool of size 1
+ * spawns no thread at all.
+ *
+ * Tasks may synchronize among themselves through barrier(), which is sized
+ * to the pool. Because of that, a task must not throw in between barriers
+ * (the other workers would wait forever); exceptions thrown at the end of a
+ * task are captured and rethrown by run(). Calls to run() from different
+ * threads are serialized, and run() must not be called from within a task.
+ */
+class CpuThreadPool {
+public:
+	typedef std::function<void(size_t worker, size_t numWorkers)> Task;
+
+
+	explicit CpuThreadPool(size_t numThreads = 0) :
+		_size(numThreads != 0 ? numThreads : defaultSize()),
+		_barrier(_size),
+		_task(NULL),
+		_generation(0),
+		_pending(0),
+		_finishing(false)
+	{
+		for (size_t w = 1; w < _size; ++w)
+			_threads.push_back(std::thread(&CpuThreadPool::work, this, w));
+	}
+
+
+	~CpuThreadPool() {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_finishing = true;
+			_startCond.notify_all();
+		}
+		for (size_t t = 0; t < _threads.size(); ++t)
+			_threads[t].join();
+	}
+
+
+	size_t size() const {
+		return _size;
+	}
+
+
+	CpuBarrier& barrier() {
+		return _barrier;
+	}
+
+
+	void run(const Task& task) {
+		std::unique_lock<std::mutex> runLock(_runMutex);
+		std::exception_ptr error;
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_task = &task;
+			_error = std::exception_ptr();
+			_pending = _size - 1;
+			_generation++;
+			_startCond.notify_all();
+		}
+
+		try {
+			task(0, _size);
+		} catch (...) {
+			error = std::current_exception();
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (_pending != 0)
+				_doneCond.wait(lock);
+			_task = NULL;
+			if (!error) error = _error;
+		}
+
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+
+	/**
+	 * Calculates the range of `n` items (e.g. matrix rows) that a worker is
+	 * responsible for, distributing them as evenly as possible.
+	 */
+	static inline void range(size_t n, size_t worker, size_t numWorkers, size_t& begin, size_t& end) {
+		begin = (n * worker) / numWorkers;
+		end = (n * (worker + 1)) / numWorkers;
+	}
+
+
+	static size_t defaultSize() {
+		size_t n = std::thread::hardware_concurrency();
+		return n == 0 ? 1 : n;
+	}
+
+private:
+	CpuThreadPool(const CpuThreadPool&);
+	CpuThreadPool& operator=(const CpuThreadPool&);
+
+
+	void work(size_t worker) {
+		size_t generation = 0;
+
+		for (;;) {
+			const Task* task;
+
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				while (!_finishing && generation == _generation)
+					_startCond.wait(lock);
+				if (_finishing)
+					return;
+				generation = _generation;
+				task = _task;
+			}
+
+			try {
+				(*task)(worker, _size);
+			} catch (...) {
+				std::unique_lock<std::mutex> lock(_mutex);
+				if (!_error) _error = std::current_exception();
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				if (--_pending == 0)
+					_doneCond.notify_all();
+			}
+		}
+	}
+
+private:
+	size_t _size;
+	CpuBarrier _barrier;
+	std::vector<std::thread> _threads;
+	std::mutex _runMutex;
+	std::mutex _mutex;
+	std::condition_variable _startCond;
+	std::condition_variable _doneCond;
+	const Task* _task;
+	std::exception_ptr _error;
+	size_t _generation;
+	size_t _pending;
+	bool _finishing;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_POOL_HPP_ */
@@ -0,0 +1,96 @@
+#ifndef UKOCT_CPU_REGISTRY_HPP_
+#define UKOCT_CPU_REGISTRY_HPP_
+
+#include "ukoct/core/defs.hpp"
+#include "ukoct/core/interface.hpp"
+#include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/operators.hpp"
+
+// Entry for the default operator of an operation (see OperationImpl)
+#define ukoct_CPUOPERATOR(oper) \
+	{ \
+		OperationImpl<T, oper>::operation, \
+		OperationImpl<T, oper>::details(), \
+		&newCpuOperator<T, typename OperationImpl<T, oper>::Impl> \
+	}
+
+// Entry for an operator variant providing getOperation() and getDetails()
+#define ukoct_CPUVARIANT(klass) \
+	{ \
+		klass<T>::getOperation(), \
+		klass<T>::getDetails(), \
+		&newCpuOperator<T, klass<T> > \
+	}
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+template <typename T> struct CpuOperatorEntry {
+	EOperation operation;
+	OperationDetails details;
+	IOperator<T>* (*create)();
+};
+
+
+template <typename T, typename O> IOperator<T>* newCpuOperator() {
+	return new O();
+}
+
+
+/**
+ * Lists all operators provided by the CPU implementation.
+ *
+ * The first entry for a given operation is its default operator, i.e. the
+ * one chosen when no details are requested. Variants must come after it.
+ */
+template <typename T> const CpuOperatorEntry<T>* cpuOperators(size_t& size) {
+	using namespace octdiff;
+	static const CpuOperatorEntry<T> entries[] = {
+		  ukoct_CPUOPERATOR(OPER_COPY)
+		, ukoct_CPUVARIANT(IsConsistentCpuOperator)
+		, ukoct_CPUOPERATOR(OPER_ISINTCONSISTENT)
+		, ukoct_CPUOPERATOR(OPER_ISCOHERENT)
+		, ukoct_CPUOPERATOR(OPER_ISCLOSED)
+		, ukoct_CPUOPERATOR(OPER_ISSTRONGLYCLOSED)
+		, ukoct_CPUOPERATOR(OPER_ISTIGHTLYCLOSED)
+		, ukoct_CPUOPERATOR(OPER_ISWEAKLYCLOSED)
+		, ukoct_CPUOPERATOR(OPER_ISTOP)
+
+		, ukoct_CPUOPERATOR(OPER_CLOSURE)
+		, ukoct_CPUVARIANT(FusedClosureCpuOperator)
+		, ukoct_CPUOPERATOR(OPER_TIGHTCLOSURE)
+		, ukoct_CPUOPERATOR(OPER_SHORTESTPATH)
+		, ukoct_CPUVARIANT(BlockedShortestPathCpuOperator)
+		, ukoct_CPUOPERATOR(OPER_STRENGTHEN)
+		, ukoct_CPUOPERATOR(OPER_TIGHTEN)
+		, ukoct_CPUOPERATOR(OPER_TOP)
+
+		, ukoct_CPUOPERATOR(OPER_PUSHDIFFCONS)
+		, ukoct_CPUOPERATOR(OPER_PUSHOCTCONS)
+		, ukoct_CPUOPERATOR(OPER_FORGETOCTVAR)
+		, ukoct_CPUOPERATOR(OPER_INCCLOSURE)
+
+		, ukoct_CPUOPERATOR(OPER_EQUALS)
+		, ukoct_CPUOPERATOR(OPER_INCLUDES)
+		, ukoct_CPUOPERATOR(OPER_UNION)
+		, ukoct_CPUOPERATOR(OPER_INTERSECTION)
+		, ukoct_CPUOPERATOR(OPER_WIDENING)
+		, ukoct_CPUOPERATOR(OPER_NARROWING)
+
+		, ukoct_CPUOPERATOR(OPER_REMOVEDIMS)
+		, ukoct_CPUOPERATOR(OPER_ADDDIMS)
+		, ukoct_CPUOPERATOR(OPER_PERMUTEDIMS)
+	};
+	size = sizeof(entries) / sizeof(entries[0]);
+	return entries;
+}
+
+}
+}
+}
+
+#undef ukoct_CPUOPERATOR
+#undef ukoct_CPUVARIANT
+
+#endif /* UKOCT_CPU_REGISTRY_HPP_ */
@@ -0,0 +1,484 @@
+#ifndef UKOCT_CPU_SIMD_HPP_
+#define UKOCT_CPU_SIMD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+#include "ukoct/core/defs.hpp"
+
+// Explicitly vectorized kernels are only provided for x86 compilers which
+// support per-function target attributes (GCC and Clang). Everything else, or
+// builds defining ukoct_CPU_NOSIMD, falls back to the scalar kernels.
+#if !defined(ukoct_CPU_NOSIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define ukoct_CPU_SIMD_X86 1
+#	include <immintrin.h>
+#endif
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Row kernels shared by the CPU operators.
+ *
+ * All kernels work on contiguous rows of `n` elements and evaluate their
+ * minimums and maximums in the same order as std::min and std::max, so the
+ * vectorized versions yield exactly the same results as the scalar ones.
+ * Sums and halves are those of ElemTypeInfo, which saturate for integers.
+ */
+template <typename T> struct CpuKernels {
+	/** row[j] = min(row[j], min(ik + rk[j], iK + rK[j])) */
+	typedef void (*RelaxPair)(T* row, const T* rk, const T* rK, T ik, T iK, size_t n);
+	/** row[j] = min(row[j], (di + d[j]) / 2) */
+	typedef void (*Strengthen)(T* row, const T* d, T di, size_t n);
+	/** dst[j] = min(a[j], b[j]), or max for the maximum kernel. dst may be a. */
+	typedef void (*Elementwise)(T* dst, const T* a, const T* b, size_t n);
+	/** Whether a[j] == b[j] for all j, or a[j] <= b[j] for lessEqual. Both return at the first block which fails. */
+	typedef bool (*Compare)(const T* a, const T* b, size_t n);
+	/**
+	 * dst[j] = b[j] <= a[j] ? a[j] : inf for widen, the widening of a by b,
+	 * and dst[j] = a[j] == inf ? b[j] : a[j] for narrow. dst may be a.
+	 */
+	typedef void (*Select)(T* dst, const T* a, const T* b, T inf, size_t n);
+
+	const char* isa;
+	RelaxPair relaxPair;
+	Strengthen strengthen;
+	Elementwise min;
+	Elementwise max;
+	Compare equal;
+	Compare lessEqual;
+	Select widen;
+	Select narrow;
+
+	/** The fastest kernels supported by the running processor. */
+	static const CpuKernels& get();
+	/** All the kernels supported by the running processor, fastest first, down to the scalar ones. */
+	static const std::vector<const CpuKernels*>& supported();
+};
+
+
+template <typename T> struct ScalarCpuKernels {
+	static void relaxPair(T* row, const T* rk, const T* rK, T ik, T iK, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			row[j] = std::min(row[j], std::min(ElemTypeInfo<T>::add(ik, rk[j]), ElemTypeInfo<T>::add(iK, rK[j])));
+	}
+
+
+	static void strengthen(T* row, const T* d, T di, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			row[j] = std::min(row[j], ElemTypeInfo<T>::half(ElemTypeInfo<T>::add(di, d[j])));
+	}
+
+
+	static void min(T* dst, const T* a, const T* b, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			dst[j] = std::min(a[j], b[j]);
+	}
+
+
+	static void max(T* dst, const T* a, const T* b, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			dst[j] = std::max(a[j], b[j]);
+	}
+
+
+	static bool equal(const T* a, const T* b, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			if (a[j] != b[j])
+				return false;
+		return true;
+	}
+
+
+	static bool lessEqual(const T* a, const T* b, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			if (a[j] > b[j])
+				return false;
+		return true;
+	}
+
+
+	static void widen(T* dst, const T* a, const T* b, T inf, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			dst[j] = b[j] <= a[j] ? a[j] : inf;
+	}
+
+
+	static void narrow(T* dst, const T* a, const T* b, T inf, size_t n) {
+		for (size_t j = 0; j < n; ++j)
+			dst[j] = a[j] == inf ? b[j] : a[j];
+	}
+
+
+	static const CpuKernels<T>& kernels() {
+		static const CpuKernels<T> k = { "scalar", &relaxPair, &strengthen, &min, &max, &equal, &lessEqual, &widen, &narrow };
+		return k;
+	}
+};
+
+
+template <typename T> const CpuKernels<T>& CpuKernels<T>::get() {
+	return ScalarCpuKernels<T>::kernels();
+}
+
+
+template <typename T> const std::vector<const CpuKernels<T>*>& CpuKernels<T>::supported() {
+	static const std::vector<const CpuKernels<T>*> k(1, &ScalarCpuKernels<T>::kernels());
+	return k;
+}
+
+
+#ifdef ukoct_CPU_SIMD_X86
+
+/*
+ * Generates a kernel set for one instruction set and element type. The
+ * intrinsics' min/max return their second operand when the comparison fails,
+ * so operands are passed as (candidate, current) to mimic std::min/std::max.
+ * Comparisons are reduced by MASK to a bitmask, which is FULL when they hold
+ * on all lanes. Tails shorter than a vector are handled by the scalar kernels.
+ * Selections are plain loops, which the compiler vectorizes for the target.
+ */
+#define ukoct_CPU_SIMDKERNELS(NAME, TARGET, T, V, LOADU, STOREU, SET1, ADD, MUL, MIN, MAX, CMPEQ, CMPLE, MASK, FULL) \
+	struct NAME { \
+		static constexpr size_t W = sizeof(V) / sizeof(T); \
+		\
+		__attribute__((target(TARGET))) \
+		static void relaxPair(T* row, const T* rk, const T* rK, T ik, T iK, size_t n) { \
+			const V vik = SET1(ik); \
+			const V viK = SET1(iK); \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) { \
+				V a = ADD(vik, LOADU(rk + j)); \
+				V b = ADD(viK, LOADU(rK + j)); \
+				STOREU(row + j, MIN(MIN(b, a), LOADU(row + j))); \
+			} \
+			ScalarCpuKernels<T>::relaxPair(row + j, rk + j, rK + j, ik, iK, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void strengthen(T* row, const T* d, T di, size_t n) { \
+			const V vdi = SET1(di); \
+			const V half = SET1((T) 0.5); \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(row + j, MIN(MUL(ADD(vdi, LOADU(d + j)), half), LOADU(row + j))); \
+			ScalarCpuKernels<T>::strengthen(row + j, d + j, di, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void min(T* dst, const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(dst + j, MIN(LOADU(b + j), LOADU(a + j))); \
+			ScalarCpuKernels<T>::min(dst + j, a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void max(T* dst, const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(dst + j, MAX(LOADU(b + j), LOADU(a + j))); \
+			ScalarCpuKernels<T>::max(dst + j, a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static bool equal(const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				if (MASK(CMPEQ(LOADU(a + j), LOADU(b + j))) != FULL) \
+					return false; \
+			return ScalarCpuKernels<T>::equal(a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static bool lessEqual(const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				if (MASK(CMPLE(LOADU(a + j), LOADU(b + j))) != FULL) \
+					return false; \
+			return ScalarCpuKernels<T>::lessEqual(a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void widen(T* dst, const T* a, const T* b, T inf, size_t n) { \
+			for (size_t j = 0; j < n; ++j) \
+				dst[j] = b[j] <= a[j] ? a[j] : inf; \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void narrow(T* dst, const T* a, const T* b, T inf, size_t n) { \
+			for (size_t j = 0; j < n; ++j) \
+				dst[j] = a[j] == inf ? b[j] : a[j]; \
+		} \
+		\
+		static const CpuKernels<T>& kernels() { \
+			static const CpuKernels<T> k = { TARGET, &relaxPair, &strengthen, &min, &max, &equal, &lessEqual, &widen, &narrow }; \
+			return k; \
+		} \
+	};
+
+#define ukoct_CPU_CMPEQ256PS(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define ukoct_CPU_CMPLE256PS(a, b) _mm256_cmp_ps(a, b, _CMP_LE_OQ)
+#define ukoct_CPU_CMPEQ256PD(a, b) _mm256_cmp_pd(a, b, _CMP_EQ_OQ)
+#define ukoct_CPU_CMPLE256PD(a, b) _mm256_cmp_pd(a, b, _CMP_LE_OQ)
+#define ukoct_CPU_CMPEQ512PS(a, b) _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)
+#define ukoct_CPU_CMPLE512PS(a, b) _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ)
+#define ukoct_CPU_CMPEQ512PD(a, b) _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ)
+#define ukoct_CPU_CMPLE512PD(a, b) _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ)
+#define ukoct_CPU_MASK(m) (m)
+
+ukoct_CPU_SIMDKERNELS(Sse2FloatCpuKernels, "sse2", float, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_add_ps, _mm_mul_ps, _mm_min_ps, _mm_max_ps, _mm_cmpeq_ps, _mm_cmple_ps, _mm_movemask_ps, 0xF)
+ukoct_CPU_SIMDKERNELS(Sse2DoubleCpuKernels, "sse2", double, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd, _mm_mul_pd, _mm_min_pd, _mm_max_pd, _mm_cmpeq_pd, _mm_cmple_pd, _mm_movemask_pd, 0x3)
+ukoct_CPU_SIMDKERNELS(Avx2FloatCpuKernels, "avx2", float, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_add_ps, _mm256_mul_ps, _mm256_min_ps, _mm256_max_ps, ukoct_CPU_CMPEQ256PS, ukoct_CPU_CMPLE256PS, _mm256_movemask_ps, 0xFF)
+ukoct_CPU_SIMDKERNELS(Avx2DoubleCpuKernels, "avx2", double, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd, _mm256_mul_pd, _mm256_min_pd, _mm256_max_pd, ukoct_CPU_CMPEQ256PD, ukoct_CPU_CMPLE256PD, _mm256_movemask_pd, 0xF)
+ukoct_CPU_SIMDKERNELS(Avx512FloatCpuKernels, "avx512f", float, __m512, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_add_ps, _mm512_mul_ps, _mm512_min_ps, _mm512_max_ps, ukoct_CPU_CMPEQ512PS, ukoct_CPU_CMPLE512PS, ukoct_CPU_MASK, 0xFFFF)
+ukoct_CPU_SIMDKERNELS(Avx512DoubleCpuKernels, "avx512f", double, __m512d, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_add_pd, _mm512_mul_pd, _mm512_min_pd, _mm512_max_pd, ukoct_CPU_CMPEQ512PD, ukoct_CPU_CMPLE512PD, ukoct_CPU_MASK, 0xFF)
+
+#undef ukoct_CPU_SIMDKERNELS
+#undef ukoct_CPU_CMPEQ256PS
+#undef ukoct_CPU_CMPLE256PS
+#undef ukoct_CPU_CMPEQ256PD
+#undef ukoct_CPU_CMPLE256PD
+#undef ukoct_CPU_CMPEQ512PS
+#undef ukoct_CPU_CMPLE512PS
+#undef ukoct_CPU_CMPEQ512PD
+#undef ukoct_CPU_CMPLE512PD
+
+
+/*
+ * Saturating sums and halves of integer vectors, as in IntElemOps: lanes
+ * where either operand is infinity (the maximum) give infinity, and lanes
+ * which overflow give the maximum or the minimum, by the sign of their
+ * operands. Halves shift right, which rounds down.
+ */
+__attribute__((target("avx2")))
+static inline __m256i avx2AddsEpi32(__m256i a, __m256i b) {
+	const __m256i inf = _mm256_set1_epi32(INT32_MAX);
+	__m256i sum = _mm256_add_epi32(a, b);
+	__m256i overflow = _mm256_and_si256(_mm256_xor_si256(a, sum), _mm256_xor_si256(b, sum));
+	__m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(a, 31), inf);
+	sum = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sum), _mm256_castsi256_ps(saturated), _mm256_castsi256_ps(overflow)));
+	return _mm256_blendv_epi8(sum, inf, _mm256_or_si256(_mm256_cmpeq_epi32(a, inf), _mm256_cmpeq_epi32(b, inf)));
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i avx2HalfEpi32(__m256i n) {
+	return _mm256_blendv_epi8(_mm256_srai_epi32(n, 1), n, _mm256_cmpeq_epi32(n, _mm256_set1_epi32(INT32_MAX)));
+}
+
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512AddsEpi32(__m512i a, __m512i b) {
+	const __m512i inf = _mm512_set1_epi32(INT32_MAX);
+	__m512i sum = _mm512_add_epi32(a, b);
+	__mmask16 overflow = _mm512_cmplt_epi32_mask(_mm512_and_si512(_mm512_xor_si512(a, sum), _mm512_xor_si512(b, sum)), _mm512_setzero_si512());
+	__mmask16 infinite = _mm512_cmpeq_epi32_mask(a, inf) | _mm512_cmpeq_epi32_mask(b, inf);
+	sum = _mm512_mask_blend_epi32(overflow, sum, _mm512_xor_si512(_mm512_srai_epi32(a, 31), inf));
+	return _mm512_mask_blend_epi32(infinite, sum, inf);
+}
+
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512HalfEpi32(__m512i n) {
+	return _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(n, _mm512_set1_epi32(INT32_MAX)), _mm512_srai_epi32(n, 1), n);
+}
+
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512AddsEpi64(__m512i a, __m512i b) {
+	const __m512i inf = _mm512_set1_epi64(INT64_MAX);
+	__m512i sum = _mm512_add_epi64(a, b);
+	__mmask8 overflow = _mm512_cmplt_epi64_mask(_mm512_and_si512(_mm512_xor_si512(a, sum), _mm512_xor_si512(b, sum)), _mm512_setzero_si512());
+	__mmask8 infinite = _mm512_cmpeq_epi64_mask(a, inf) | _mm512_cmpeq_epi64_mask(b, inf);
+	sum = _mm512_mask_blend_epi64(overflow, sum, _mm512_xor_si512(_mm512_srai_epi64(a, 63), inf));
+	return _mm512_mask_blend_epi64(infinite, sum, inf);
+}
+
+
+__attribute__((target("avx512f")))
+static inline __m512i avx512HalfEpi64(__m512i n) {
+	return _mm512_mask_blend_epi64(_mm512_cmpeq_epi64_mask(n, _mm512_set1_epi64(INT64_MAX)), _mm512_srai_epi64(n, 1), n);
+}
+
+
+#define ukoct_CPU_LOADU256(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+#define ukoct_CPU_STOREU256(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v)
+#define ukoct_CPU_LOADU512(p) _mm512_loadu_si512(p)
+#define ukoct_CPU_STOREU512(p, v) _mm512_storeu_si512(p, v)
+#define ukoct_CPU_CMPLE256EPI32(a, b) _mm256_xor_si256(_mm256_cmpgt_epi32(a, b), _mm256_set1_epi32(-1))
+
+/* The same kernels for integer elements, with saturating sums. */
+#define ukoct_CPU_SIMDINTKERNELS(NAME, TARGET, T, V, LOADU, STOREU, SET1, ADDS, HALF, MIN, MAX, CMPEQ, CMPLE, MASK, FULL) \
+	struct NAME { \
+		static constexpr size_t W = sizeof(V) / sizeof(T); \
+		\
+		__attribute__((target(TARGET))) \
+		static void relaxPair(T* row, const T* rk, const T* rK, T ik, T iK, size_t n) { \
+			const V vik = SET1(ik); \
+			const V viK = SET1(iK); \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) { \
+				V a = ADDS(vik, LOADU(rk + j)); \
+				V b = ADDS(viK, LOADU(rK + j)); \
+				STOREU(row + j, MIN(MIN(b, a), LOADU(row + j))); \
+			} \
+			ScalarCpuKernels<T>::relaxPair(row + j, rk + j, rK + j, ik, iK, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void strengthen(T* row, const T* d, T di, size_t n) { \
+			const V vdi = SET1(di); \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(row + j, MIN(HALF(ADDS(vdi, LOADU(d + j))), LOADU(row + j))); \
+			ScalarCpuKernels<T>::strengthen(row + j, d + j, di, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void min(T* dst, const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(dst + j, MIN(LOADU(b + j), LOADU(a + j))); \
+			ScalarCpuKernels<T>::min(dst + j, a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void max(T* dst, const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				STOREU(dst + j, MAX(LOADU(b + j), LOADU(a + j))); \
+			ScalarCpuKernels<T>::max(dst + j, a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static bool equal(const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				if (MASK(CMPEQ(LOADU(a + j), LOADU(b + j))) != FULL) \
+					return false; \
+			return ScalarCpuKernels<T>::equal(a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static bool lessEqual(const T* a, const T* b, size_t n) { \
+			size_t j = 0; \
+			for (; j + W <= n; j += W) \
+				if (MASK(CMPLE(LOADU(a + j), LOADU(b + j))) != FULL) \
+					return false; \
+			return ScalarCpuKernels<T>::lessEqual(a + j, b + j, n - j); \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void widen(T* dst, const T* a, const T* b, T inf, size_t n) { \
+			for (size_t j = 0; j < n; ++j) \
+				dst[j] = b[j] <= a[j] ? a[j] : inf; \
+		} \
+		\
+		__attribute__((target(TARGET))) \
+		static void narrow(T* dst, const T* a, const T* b, T inf, size_t n) { \
+			for (size_t j = 0; j < n; ++j) \
+				dst[j] = a[j] == inf ? b[j] : a[j]; \
+		} \
+		\
+		static const CpuKernels<T>& kernels() { \
+			static const CpuKernels<T> k = { TARGET, &relaxPair, &strengthen, &min, &max, &equal, &lessEqual, &widen, &narrow }; \
+			return k; \
+		} \
+	};
+
+ukoct_CPU_SIMDINTKERNELS(Avx2Int32CpuKernels, "avx2", int32_t, __m256i, ukoct_CPU_LOADU256, ukoct_CPU_STOREU256, _mm256_set1_epi32, avx2AddsEpi32, avx2HalfEpi32, _mm256_min_epi32, _mm256_max_epi32, _mm256_cmpeq_epi32, ukoct_CPU_CMPLE256EPI32, _mm256_movemask_epi8, -1)
+ukoct_CPU_SIMDINTKERNELS(Avx512Int32CpuKernels, "avx512f", int32_t, __m512i, ukoct_CPU_LOADU512, ukoct_CPU_STOREU512, _mm512_set1_epi32, avx512AddsEpi32, avx512HalfEpi32, _mm512_min_epi32, _mm512_max_epi32, _mm512_cmpeq_epi32_mask, _mm512_cmple_epi32_mask, ukoct_CPU_MASK, 0xFFFF)
+ukoct_CPU_SIMDINTKERNELS(Avx512Int64CpuKernels, "avx512f", int64_t, __m512i, ukoct_CPU_LOADU512, ukoct_CPU_STOREU512, _mm512_set1_epi64, avx512AddsEpi64, avx512HalfEpi64, _mm512_min_epi64, _mm512_max_epi64, _mm512_cmpeq_epi64_mask, _mm512_cmple_epi64_mask, ukoct_CPU_MASK, 0xFF)
+
+#undef ukoct_CPU_SIMDINTKERNELS
+#undef ukoct_CPU_LOADU256
+#undef ukoct_CPU_STOREU256
+#undef ukoct_CPU_LOADU512
+#undef ukoct_CPU_STOREU512
+#undef ukoct_CPU_CMPLE256EPI32
+#undef ukoct_CPU_MASK
+
+
+/*
+ * The kernels of each instruction set the processor supports, in order of
+ * preference. get() picks the first of them.
+ */
+template <> inline const std::vector<const CpuKernels<float>*>& CpuKernels<float>::supported() {
+	static const std::vector<const CpuKernels<float>*> k = []() {
+		std::vector<const CpuKernels<float>*> ret;
+		if (__builtin_cpu_supports("avx512f")) ret.push_back(&Avx512FloatCpuKernels::kernels());
+		if (__builtin_cpu_supports("avx2")) ret.push_back(&Avx2FloatCpuKernels::kernels());
+		if (__builtin_cpu_supports("sse2")) ret.push_back(&Sse2FloatCpuKernels::kernels());
+		ret.push_back(&ScalarCpuKernels<float>::kernels());
+		return ret;
+	}();
+	return k;
+}
+
+
+template <> inline const std::vector<const CpuKernels<double>*>& CpuKernels<double>::supported() {
+	static const std::vector<const CpuKernels<double>*> k = []() {
+		std::vector<const CpuKernels<double>*> ret;
+		if (__builtin_cpu_supports("avx512f")) ret.push_back(&Avx512DoubleCpuKernels::kernels());
+		if (__builtin_cpu_supports("avx2")) ret.push_back(&Avx2DoubleCpuKernels::kernels());
+		if (__builtin_cpu_supports("sse2")) ret.push_back(&Sse2DoubleCpuKernels::kernels());
+		ret.push_back(&ScalarCpuKernels<double>::kernels());
+		return ret;
+	}();
+	return k;
+}
+
+
+template <> inline const std::vector<const CpuKernels<int32_t>*>& CpuKernels<int32_t>::supported() {
+	static const std::vector<const CpuKernels<int32_t>*> k = []() {
+		std::vector<const CpuKernels<int32_t>*> ret;
+		if (__builtin_cpu_supports("avx512f")) ret.push_back(&Avx512Int32CpuKernels::kernels());
+		if (__builtin_cpu_supports("avx2")) ret.push_back(&Avx2Int32CpuKernels::kernels());
+		ret.push_back(&ScalarCpuKernels<int32_t>::kernels());
+		return ret;
+	}();
+	return k;
+}
+
+
+template <> inline const std::vector<const CpuKernels<int64_t>*>& CpuKernels<int64_t>::supported() {
+	static const std::vector<const CpuKernels<int64_t>*> k = []() {
+		std::vector<const CpuKernels<int64_t>*> ret;
+		if (__builtin_cpu_supports("avx512f")) ret.push_back(&Avx512Int64CpuKernels::kernels());
+		ret.push_back(&ScalarCpuKernels<int64_t>::kernels());
+		return ret;
+	}();
+	return k;
+}
+
+
+template <> inline const CpuKernels<float>& CpuKernels<float>::get() {
+	return *supported().front();
+}
+
+
+template <> inline const CpuKernels<double>& CpuKernels<double>::get() {
+	return *supported().front();
+}
+
+
+template <> inline const CpuKernels<int32_t>& CpuKernels<int32_t>::get() {
+	return *supported().front();
+}
+
+
+template <> inline const CpuKernels<int64_t>& CpuKernels<int64_t>::get() {
+	return *supported().front();
+}
+
+#endif /* ukoct_CPU_SIMD_X86 */
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_SIMD_HPP_ */
@@ -0,0 +1,84 @@
+#ifndef UKOCT_CPU_SNAPSHOT_HPP_
+#define UKOCT_CPU_SNAPSHOT_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "plas.hpp"
+
+#include "ukoct/core/defs.hpp"
+#include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/allocator.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Header of a DBM snapshot file, as written by CpuState::save() and mapped
+ * by CpuState::map().
+ *
+ * The header is followed, at `offset` bytes from the start of the file, by
+ * the diffSize x diffSize matrix in the given ordering, with its rows (or
+ * columns) padded to `pitch` elements, just as a CpuState keeps it in memory.
+ * `offset` is a multiple of ukoct_CPU_ALIGNMENT, so a mapped matrix is as
+ * aligned as an allocated one. All fields are in native byte order.
+ */
+struct CpuSnapshotHeader {
+	static constexpr uint32_t currentVersion = 1;
+
+	char magic[8];          //!< "UKOCTDBM"
+	uint32_t version;       //!< Format version, currently 1.
+	uint32_t elemType;      //!< ukoct::EElemType
+	uint32_t elemSize;      //!< sizeof of the element type
+	uint32_t ordering;      //!< plas::EMatrixOrdering
+	uint64_t diffSize;
+	uint64_t pitch;         //!< In elements.
+	uint64_t offset;        //!< Of the matrix, in bytes.
+	uint32_t flagsKnown;    //!< @see CpuStateFlags
+	uint32_t flagsValues;
+
+
+	static size_t matrixOffset() {
+		return (sizeof(CpuSnapshotHeader) + ukoct_CPU_ALIGNMENT - 1) / ukoct_CPU_ALIGNMENT * ukoct_CPU_ALIGNMENT;
+	}
+
+
+	template <typename T> void init(size_t n, size_t p, plas::EMatrixOrdering order, unsigned int known, unsigned int values) {
+		std::memset(this, 0, sizeof(*this));
+		std::memcpy(magic, "UKOCTDBM", sizeof(magic));
+		version = currentVersion;
+		elemType = ElemTypeInfo<T>::elemType;
+		elemSize = sizeof(T);
+		ordering = order;
+		diffSize = n;
+		pitch = p;
+		offset = matrixOffset();
+		flagsKnown = known;
+		flagsValues = values;
+	}
+
+
+	/** Throws an Error unless this header describes a matrix of T which fits in fileSize bytes. */
+	template <typename T> void validate(size_t fileSize) const {
+		if (fileSize < sizeof(*this) || std::memcmp(magic, "UKOCTDBM", sizeof(magic)) != 0)
+			throw Error("Not a DBM snapshot.");
+		if (version != currentVersion)
+			throw Error("Unsupported DBM snapshot version.");
+		if (elemType != ElemTypeInfo<T>::elemType || elemSize != sizeof(T))
+			throw Error("DBM snapshot element type mismatch.");
+		if (ordering != plas::MATRIX_ROWMAJOR && ordering != plas::MATRIX_COLMAJOR)
+			throw Error("Invalid DBM snapshot ordering.");
+		// Sizes come from the file, so they're compared by division, which can't wrap
+		if (diffSize < 2 || diffSize % 2 != 0 || pitch < diffSize || pitch > SIZE_MAX / sizeof(T) || pitch != CpuAllocator::pitch<T>(diffSize))
+			throw Error("Invalid DBM snapshot dimensions.");
+		if (offset % ukoct_CPU_ALIGNMENT != 0 || offset < sizeof(*this) || offset > fileSize || diffSize > (fileSize - offset) / (pitch * sizeof(T)))
+			throw Error("Truncated or misaligned DBM snapshot.");
+	}
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_SNAPSHOT_HPP_ */
@@ -0,0 +1,89 @@
+#ifndef UKOCT_CPU_SPARSE_HPP_
+#define UKOCT_CPU_SPARSE_HPP_
+
+#include <vector>
+#include <algorithm>
+
+#include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/simd.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Finite entries of a pair of pivot rows, for sparse row relaxation.
+ *
+ * Relaxing a row through a pivot pair only changes the columns in which one
+ * of the pivot rows is finite, and only if the row reaches the pivots at all.
+ * build() gathers those columns; relax() then touches just them when the
+ * pivots are sparse enough (see ukoct_CPU_SPARSEDENSITY), and falls back to
+ * the vectorized dense kernel otherwise. Both give the same results.
+ */
+template <typename T> class CpuPivotIndex {
+public:
+	CpuPivotIndex(size_t n, T infinity) :
+		_kernels(CpuKernels<T>::get()),
+		_cols(),
+		_infinity(infinity),
+		_sparse(false)
+	{
+		_cols.reserve(n);
+	}
+
+
+	void build(const T* rk, const T* rK, size_t n) {
+		_cols.clear();
+
+		for (size_t j = 0; j < n; ++j)
+			if (rk[j] < _infinity || rK[j] < _infinity)
+				_cols.push_back(j);
+
+		_sparse = _cols.size() < ukoct_CPU_SPARSEDENSITY * n;
+	}
+
+
+	bool sparse() const {
+		return _sparse;
+	}
+
+
+	size_t count() const {
+		return _cols.size();
+	}
+
+
+	/** Whether a row reaching the pivots with costs ik and iK can change at all. */
+	inline bool reaches(T ik, T iK) const {
+		return !_cols.empty() && (ik < _infinity || iK < _infinity);
+	}
+
+
+	/** row[j] = min(row[j], min(ik + rk[j], iK + rK[j])), for j < n. */
+	inline void relax(T* row, const T* rk, const T* rK, T ik, T iK, size_t n) const {
+		if (!reaches(ik, iK))
+			return;
+
+		if (!_sparse) {
+			_kernels.relaxPair(row, rk, rK, ik, iK, n);
+			return;
+		}
+
+		for (size_t c = 0; c < _cols.size() && _cols[c] < n; ++c) {
+			size_t j = _cols[c];
+			row[j] = std::min(row[j], std::min(ElemTypeInfo<T>::add(ik, rk[j]), ElemTypeInfo<T>::add(iK, rK[j])));
+		}
+	}
+
+private:
+	const CpuKernels<T>& _kernels;
+	std::vector<size_t> _cols;
+	T _infinity;
+	bool _sparse;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_SPARSE_HPP_ */
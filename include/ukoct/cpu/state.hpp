@@ -2,44 +2,107 @@
 #define UKOCT_CPU_STATE_HPP_
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "plas.hpp"
 
 #include "ukoct/cpu/base.hpp"
+#include "ukoct/cpu/allocator.hpp"
+#include "ukoct/cpu/pool.hpp"
+#include "ukoct/cpu/partition.hpp"
+#include "ukoct/cpu/snapshot.hpp"
+#include "ukoct/cpu/flags.hpp"
+#include "ukoct/cpu/view.hpp"
 #include "ukoct/cpu/operators.hpp"
+#include "ukoct/cpu/registry.hpp"
 
 namespace ukoct{
 
+/**
+ * A full matrix state. The matrix is kept in a buffer from the
+ * implementation's allocator, whose rows are aligned and padded to pitch()
+ * elements (see impl::cpu::CpuAllocator::pitch()); the padding is left at
+ * infinity, and isn't part of the matrix.
+ *
+ * Copies (and clones) share the buffer, which is reference counted, until
+ * one of them is about to be mutated (see detach()).
+ */
 template <typename T> class CpuState : public IState<T> {
 public:
 	CpuState() :
 		_valid(false),
 		_impl(NULL),
 		_selfImpl(NULL),
-		_self() {}
+		_data(NULL),
+		_buffer(NULL),
+		_n(0),
+		_pitch(0),
+		_self(),
+		_partition(),
+		_flags(),
+		_fingerprint(0),
+		_fingerprinted(false) {}
 
 
 	CpuState(const CpuState<T>& other)  :
 		_valid(other._valid),
 		_impl(other._impl),
-		_selfImpl(other._selfImpl),
-		_self(other._self) {}
+		_selfImpl(NULL),
+		_data(other._data),
+		_buffer(other._buffer),
+		_n(other._n),
+		_pitch(other._pitch),
+		_self(other._self),
+		_partition(other._partition),
+		_flags(other._flags),
+		_fingerprint(other._fingerprint),
+		_fingerprinted(other._fingerprinted) {
+		if (_buffer != NULL)
+			++_buffer->refs;
+	}
 
 
 	CpuState(const CpuImplementation<T>* impl) :
 		_valid(false),
 		_impl(impl),
 		_selfImpl(NULL),
-		_self() {}
+		_data(NULL),
+		_buffer(NULL),
+		_n(0),
+		_pitch(0),
+		_self(),
+		_partition(),
+		_flags(),
+		_fingerprint(0),
+		_fingerprinted(false) {}
 
 
 	CpuState(CpuImplementation<T>* impl)  :
 		_valid(false),
 		_impl(impl),
 		_selfImpl(impl),
-		_self() {}
+		_data(NULL),
+		_buffer(NULL),
+		_n(0),
+		_pitch(0),
+		_self(),
+		_partition(),
+		_flags(),
+		_fingerprint(0),
+		_fingerprinted(false) {}
 
 
 	~CpuState() {
+		release();
 		delete _selfImpl;
 	}
 
@@ -50,6 +113,12 @@ public:
 	}
 
 
+	const CpuImplementation<T>& cpuImplementation() const {
+		ukoct::assert(_impl != NULL, "Missing internal IImplementation pointer.");
+		return *_impl;
+	}
+
+
 	CpuState<T>* clone() const {
 		return new CpuState<T>(*this);
 	}
@@ -61,7 +130,13 @@ public:
 
 
 	size_t implSize() const {
-		return _self.colsize();
+		return _n;
+	}
+
+
+	/** Distance (in elements) between the starts of two consecutive rows of the raw buffer. */
+	size_t pitch() const {
+		return _pitch;
 	}
 
 
@@ -71,7 +146,8 @@ public:
 
 
 	void copyTo(T* ptr) const {
-		std::copy(_self.raw(), _self.raw() + (implSize() * implSize()), ptr);
+		for (size_t i = 0; i < _n; ++i)
+			std::copy(_data + i * _pitch, _data + i * _pitch + _n, ptr + i * _n);
 	}
 
 
@@ -80,10 +156,266 @@ public:
 	}
 
 
+	/** Whether the matrix buffer is shared with other states. */
+	bool shared() const {
+		return _buffer != NULL && _buffer->refs > 1;
+	}
+
+
+	/**
+	 * Gives this state a buffer of its own, if shared, and forgets its
+	 * fingerprint. Mutators are detached before running (see
+	 * AbstractCpuOperator::prepare()), and code writing to input() directly
+	 * must detach the state first.
+	 */
+	void detach() {
+		if (shared()) {
+			CpuState<T> source(*this);
+			allocate(_n, _self.ordering());
+			std::copy(source._data, source._data + bufferSize(), _data);
+		}
+		_fingerprinted = false;
+	}
+
+
+	/**
+	 * A 64-bit hash of the matrix in its own ordering, computed when first
+	 * asked for and kept until the state is next detached. Copies keep it
+	 * along with the buffer. Equal matrices of the same ordering have equal
+	 * fingerprints, so differing ones tell unequal matrices apart in O(1).
+	 * OPER_EQUALS only uses fingerprints which are already known, so it's up
+	 * to callers comparing a matrix against many others to compute them.
+	 */
+	uint64_t fingerprint() const {
+		if (!_fingerprinted) {
+			std::hash<T> hash;
+			uint64_t h = 14695981039346656037ULL;
+			for (size_t i = 0; i < _n; ++i) {
+				for (size_t j = 0; j < _n; ++j) {
+					h = (h ^ hash(_data[i * _pitch + j])) * 1099511628211ULL;
+					h ^= h >> 29;
+				}
+			}
+			_fingerprint = h;
+			_fingerprinted = true;
+		}
+		return _fingerprint;
+	}
+
+
+	/** Whether the fingerprint is known, without computing it. */
+	bool fingerprinted() const {
+		return _fingerprinted;
+	}
+
+
+	/** Takes the fingerprint of a state found to hold the same matrix, in the same ordering. */
+	void adoptFingerprint(const CpuState<T>& same) {
+		_fingerprint = same._fingerprint;
+		_fingerprinted = same._fingerprinted;
+	}
+
+
+	/** Makes this state share the matrix of another one, of the same implementation. */
+	void share(const CpuState<T>& other) {
+		if (other._buffer == _buffer)
+			return;
+
+		if (other._buffer != NULL)
+			++other._buffer->refs;
+		release();
+		_data = other._data;
+		_buffer = other._buffer;
+		_n = other._n;
+		_pitch = other._pitch;
+		_self = other._self;
+		_fingerprint = other._fingerprint;
+		_fingerprinted = other._fingerprinted;
+	}
+
+
+	/**
+	 * Gives this state an uninitialized matrix of the same size and ordering
+	 * as another state's, to be entirely overwritten. Its own buffer is kept
+	 * if not shared and of the right size. Flags and fingerprint are
+	 * forgotten and the partition invalidated.
+	 */
+	void reshape(const CpuState<T>& like) {
+		if (&like == this)
+			return;
+
+		if (_buffer == NULL || shared() || _n != like._n)
+			allocate(like._n, like._self.ordering());
+		else
+			_self = plas::DenseMatrix<T>(_data, _n, _pitch, like._self.ordering());
+		_partition.invalidate();
+		_flags.forget();
+		_fingerprinted = false;
+		_valid = true;
+	}
+
+
+	/**
+	 * Rebuilds the matrix over octSize octagonal variables, in a single pass:
+	 * (0-based) variable v becomes variable to[v], or is dropped if to[v] >=
+	 * octSize, and variables no old one maps to are unconstrained. The rows
+	 * and columns are moved alike, so the ordering is kept. The partition is
+	 * carried over (see CpuPartition::remap()) and the fingerprint forgotten,
+	 * flags are left to the caller.
+	 */
+	void remapVars(const std::vector<size_t>& to, size_t octSize) {
+		ukoct::assert(to.size() == _n / 2, "Variable mapping size mismatch.");
+		size_t n = 2 * octSize;
+		T infinity = implementation().infinity();
+
+		// Difference index of the old matrix for each new one, if any
+		std::vector<size_t> from(n, _n);
+		for (size_t v = 0; v < to.size(); ++v) {
+			if (to[v] < octSize) {
+				from[2 * to[v]] = 2 * v;
+				from[2 * to[v] + 1] = 2 * v + 1;
+			}
+		}
+
+		// Runs of consecutive new indices coming from consecutive old ones,
+		// as (start, length) pairs, and whether any new index is left out
+		std::vector<std::pair<size_t, size_t> > runs;
+		bool added = false;
+		for (size_t j = 0; j < n; ++j) {
+			if (from[j] >= _n)
+				added = true;
+			else if (!runs.empty() && runs.back().first + runs.back().second == j && from[j - 1] + 1 == from[j])
+				++runs.back().second;
+			else
+				runs.push_back(std::make_pair(j, static_cast<size_t>(1)));
+		}
+
+		CpuState<T> source(*this);
+		allocate(n, source._self.ordering());
+
+		for (size_t i = 0; i < n; ++i) {
+			T* row = _data + i * _pitch;
+
+			if (added)
+				std::fill(row, row + n, infinity);
+			if (from[i] >= source._n) {
+				row[i] = 0;
+				continue;
+			}
+
+			const T* src = source._data + from[i] * source._pitch;
+			for (size_t r = 0; r < runs.size(); ++r)
+				std::copy(src + from[runs[r].first], src + from[runs[r].first] + runs[r].second, row + runs[r].first);
+		}
+
+		_partition.remap(to, octSize);
+	}
+
+
+	/**
+	 * Unchecked, 0-based row-major view of the matrix, for operators which
+	 * are indifferent to its actual ordering (see impl::cpu::CpuMatrixView).
+	 */
+	impl::cpu::CpuMatrixView<T> view() {
+		return impl::cpu::CpuMatrixView<T>(_data, _n, _pitch);
+	}
+
+
 	void setup(size_t diffSize, T* rawInput, bool rowMajor) {
 		assertStateOptions(_valid, diffSize, rawInput, rowMajor);
-		_self = plas::DenseMatrix<T>(diffSize, diffSize, rowMajor ? plas::MATRIX_ROWMAJOR : plas::MATRIX_COLMAJOR, implementation().infinity());
-		std::copy(rawInput, rawInput + (diffSize * diffSize), _self.raw());
+		allocate(diffSize, rowMajor ? plas::MATRIX_ROWMAJOR : plas::MATRIX_COLMAJOR);
+		for (size_t i = 0; i < diffSize; ++i)
+			std::copy(rawInput + i * diffSize, rawInput + (i + 1) * diffSize, _data + i * _pitch);
+		_partition.invalidate();
+		_flags.forget();
+		_valid = true;
+	}
+
+
+	/**
+	 * Writes the matrix and its known flags to a snapshot file (see
+	 * impl::cpu::CpuSnapshotHeader). Throws an Error on failure.
+	 */
+	void save(const std::string& path) const {
+		ukoct::assert(isValid(), "State must be set up before being saved.");
+		impl::cpu::CpuSnapshotHeader header;
+		header.init<T>(_n, _pitch, _self.ordering(), _flags.knownMask(), _flags.valueMask());
+		std::vector<char> padding(header.offset - sizeof(header), 0);
+
+		std::ofstream os(path.c_str(), std::ios::binary | std::ios::trunc);
+		os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		os.write(&padding[0], padding.size());
+		os.write(reinterpret_cast<const char*>(_data), bufferSize() * sizeof(T));
+		if (!os)
+			throw Error("Could not write DBM snapshot " + path + ".");
+	}
+
+
+	/**
+	 * Sets the state up from a snapshot file, which is mapped in place
+	 * rather than read. The mapping is private: the state may be mutated as
+	 * usual, but the file itself is never written to. Copies of the state
+	 * share the mapping, which is unmapped when the last of them is gone.
+	 * Throws an Error if the file can't be mapped, or isn't a snapshot of
+	 * a matrix of T.
+	 */
+	void map(const std::string& path) {
+		ukoct::assert(!_valid, "State already initialized.");
+		int fd = ::open(path.c_str(), O_RDONLY);
+		struct stat st;
+
+		if (fd < 0 || ::fstat(fd, &st) != 0) {
+			if (fd >= 0)
+				::close(fd);
+			throw Error("Could not open DBM snapshot " + path + ".");
+		}
+
+		size_t size = static_cast<size_t>(st.st_size);
+		void* mapping = size > 0 ? ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+		::close(fd);
+		if (mapping == MAP_FAILED)
+			throw Error("Could not map DBM snapshot " + path + ".");
+
+		const impl::cpu::CpuSnapshotHeader& header = *static_cast<const impl::cpu::CpuSnapshotHeader*>(mapping);
+		try {
+			header.validate<T>(size);
+		} catch (...) {
+			::munmap(mapping, size);
+			throw;
+		}
+
+		release();
+		_buffer = new Buffer(mapping, size);
+		_data = reinterpret_cast<T*>(static_cast<char*>(mapping) + header.offset);
+		_n = header.diffSize;
+		_pitch = header.pitch;
+		_self = plas::DenseMatrix<T>(_data, _n, _pitch, static_cast<plas::EMatrixOrdering>(header.ordering));
+		_fingerprinted = false;
+		_partition.invalidate();
+		_flags.forget();
+		_flags.set(header.flagsKnown & header.flagsValues & impl::cpu::CPUSTATE_ALL, true);
+		_flags.set(header.flagsKnown & ~header.flagsValues & impl::cpu::CPUSTATE_ALL, false);
+		_valid = true;
+	}
+
+
+	/**
+	 * Sets the state up from a text `oct` or `octdiff` problem, which is
+	 * streamed straight into the matrix (see plas::openOctDiff()) rather
+	 * than opened and converted, keeping the tightest constant given for
+	 * each cell. The problem gets everything else from the file, and its
+	 * entries only if keepEntries. Throws an Error if the problem is invalid,
+	 * or doesn't declare its number of variables.
+	 */
+	template <template <typename> class M> void load(std::istream& is, plas::Problem<T, M>& problem, bool keepEntries = false) {
+		ukoct::assert(!_valid, "State already initialized.");
+		Loader loader(*this);
+		if (!plas::openOctDiff(is, problem, loader, keepEntries) || _data == NULL) {
+			release();
+			throw Error("Could not load problem into the state.");
+		}
+		_partition.invalidate();
+		_flags.forget();
 		_valid = true;
 	}
 
@@ -92,18 +424,186 @@ public:
 		return _self;
 	}
 
+
+	/**
+	 * The partition of variables into independent components.
+	 *
+	 * Operators mutating the matrix keep it up to date, or invalidate it so
+	 * it's rebuilt from the matrix when needed (`build`). Code writing to
+	 * input() directly must invalidate it as well.
+	 */
+	impl::cpu::CpuPartition& partition(bool build = true) {
+		if (build && !_partition.valid())
+			_partition.build(_data, _n, _pitch, implementation().infinity());
+		return _partition;
+	}
+
+
+	/**
+	 * Known properties of the matrix. As with the partition, code writing to
+	 * input() directly must forget them.
+	 */
+	impl::cpu::CpuStateFlags& flags() {
+		return _flags;
+	}
+
 private:
+	/* Reference counted owner of the matrix buffer, which is either allocated or mapped from a snapshot. */
+	struct Buffer {
+		Buffer(void* mapping, size_t mappedBytes) :
+			refs(1),
+			mapping(mapping),
+			mappedBytes(mappedBytes) {}
+
+		std::atomic<size_t> refs;
+		void* mapping;
+		size_t mappedBytes;
+	};
+
+
+	/* Writes a streamed problem into a freshly allocated row-major buffer (see load()). */
+	class Loader : public plas::IOctDiffSink<T> {
+	public:
+		explicit Loader(CpuState<T>& state) :
+			_state(state) {}
+
+
+		bool resize(plas::var_t diffSize) {
+			if (diffSize < 2 || diffSize % 2 != 0)
+				return false;
+			_state.allocate(diffSize, plas::MATRIX_ROWMAJOR);
+			std::fill(_state._data, _state._data + _state.bufferSize(), _state.implementation().infinity());
+			return true;
+		}
+
+
+		void tighten(plas::var_t row, plas::var_t col, T d) {
+			size_t n = _state._n;
+			if (row > 0 && col > 0 && static_cast<size_t>(row) <= n && static_cast<size_t>(col) <= n) {
+				T& cell = _state._data[(row - 1) * _state._pitch + col - 1];
+				if (d < cell)
+					cell = d;
+			}
+		}
+
+	private:
+		CpuState<T>& _state;
+	};
+
+
+	CpuState<T>& operator=(const CpuState<T>&);
+
+
+	size_t bufferSize() const {
+		return _n * _pitch;
+	}
+
+
+	/*
+	 * Replaces the buffer with an uninitialized n x n one, whose padding is
+	 * set to infinity. The Buffer is kept in a header at the start of the
+	 * allocated block, padded to the alignment so the matrix stays aligned.
+	 */
+	void allocate(size_t n, plas::EMatrixOrdering ordering) {
+		release();
+		_n = n;
+		_pitch = impl::cpu::CpuAllocator::pitch<T>(n);
+		char* block = static_cast<char*>(cpuImplementation().allocator()->allocate(blockSize()));
+		_buffer = new (block) Buffer(NULL, 0);
+		_data = reinterpret_cast<T*>(block + headerSize());
+		_self = plas::DenseMatrix<T>(_data, _n, _pitch, ordering);
+		_fingerprinted = false;
+
+		if (_pitch > _n)
+			for (size_t i = 0; i < _n; ++i)
+				std::fill(_data + i * _pitch + _n, _data + (i + 1) * _pitch, implementation().infinity());
+	}
+
+
+	static size_t headerSize() {
+		return (sizeof(Buffer) + ukoct_CPU_ALIGNMENT - 1) / ukoct_CPU_ALIGNMENT * ukoct_CPU_ALIGNMENT;
+	}
+
+
+	size_t blockSize() const {
+		return headerSize() + bufferSize() * sizeof(T);
+	}
+
+
+	/* Drops this state's reference to the buffer, which is released once unreferenced. */
+	void release() {
+		if (_buffer != NULL && --_buffer->refs == 0) {
+			if (_buffer->mapping != NULL) {
+				::munmap(_buffer->mapping, _buffer->mappedBytes);
+				delete _buffer;
+			} else {
+				_buffer->~Buffer();
+				cpuImplementation().allocator()->release(_buffer, blockSize());
+			}
+		}
+		_data = NULL;
+		_buffer = NULL;
+		_self = plas::DenseMatrix<T>();
+	}
+
 	bool _valid;
 	ukoct::CpuImplementation<T>* _selfImpl;
 	const ukoct::CpuImplementation<T>* _impl;
+	T* _data;
+	Buffer* _buffer;
+	size_t _n;
+	size_t _pitch;
 	plas::DenseMatrix<T> _self;
+	impl::cpu::CpuPartition _partition;
+	impl::cpu::CpuStateFlags _flags;
+	mutable uint64_t _fingerprint;
+	mutable bool _fingerprinted;
 };
 
 
-template <typename T> class CpuImplementation : public IImplementation<T> {
+/**
+ * Common base of the CPU implementations.
+ *
+ * If constructed with `numThreads` different from 1, the implementation owns
+ * a persistent thread pool of that size (0 meaning one thread per hardware
+ * thread), which operators use to split their work for problems with at least
+ * ukoct_CPU_PARALLELSIZE rows. The pool is an execution resource, not an
+ * operation state, and is shared by all states created by the implementation.
+ *
+ * Subclasses provide the state type and the table of operators.
+ */
+template <typename T> class AbstractCpuImplementation : public IImplementation<T> {
 public:
-	EImplementation type() const {
-		return IMPL_CPU;
+	explicit AbstractCpuImplementation(size_t numThreads = 1, impl::cpu::CpuAllocator* allocator = NULL) :
+		_pool(numThreads != 1 ? new impl::cpu::CpuThreadPool(numThreads) : NULL),
+		_allocator(allocator != NULL ? allocator : new impl::cpu::CpuArenaAllocator()),
+		_ownsAllocator(allocator == NULL) {}
+
+
+	virtual ~AbstractCpuImplementation() {
+		delete _pool;
+		if (_ownsAllocator)
+			delete _allocator;
+	}
+
+
+	size_t numThreads() const {
+		return _pool != NULL ? _pool->size() : 1;
+	}
+
+
+	impl::cpu::CpuThreadPool* pool() const {
+		return _pool;
+	}
+
+
+	impl::cpu::CpuAllocator* allocator() const {
+		return _allocator;
+	}
+
+
+	bool parallel(size_t diffSize) const {
+		return _pool != NULL && _pool->size() > 1 && diffSize >= ukoct_CPU_PARALLELSIZE;
 	}
 
 
@@ -122,18 +622,70 @@ public:
 	}
 
 
-	CpuState<T>* newState() const {
-		return new CpuState<T>(this);
+	void getDetails(std::map<EOperation, std::vector<OperationDetails> >& result, size_t maxOpers = 0, EOperation oper = OPER_NONE, OperationDetails details = 0, bool matchAnyDetails = false) const {
+		size_t numOperators;
+		size_t operCount = 0;
+		const impl::cpu::CpuOperatorEntry<T>* entries = operatorEntries(numOperators);
+
+		for (size_t i = 0; i < numOperators && (maxOpers == 0 || operCount < maxOpers); ++i) {
+			const impl::cpu::CpuOperatorEntry<T>& entry = entries[i];
+			if ((oper == OPER_NONE || entry.operation == oper) && entry.details.matches(details, matchAnyDetails)) {
+				result[entry.operation].push_back(entry.details);
+				operCount++;
+			}
+		}
 	}
 
 
-	void getDetails(std::map<EOperation, std::vector<OperationDetails> >& result, size_t maxOpers = 0, EOperation oper = OPER_NONE, OperationDetails details = 0, bool matchAnyDetails = false) const {
+	void filterOperators(std::vector<IOperator<T>*>& result, size_t maxOpers = 0, EOperation oper = OPER_NONE, OperationDetails details = 0, bool matchAnyDetails = false) const {
+		size_t numOperators;
+		size_t operCount = 0;
+		const impl::cpu::CpuOperatorEntry<T>* entries = operatorEntries(numOperators);
+
+		for (size_t i = 0; i < numOperators && (maxOpers == 0 || operCount < maxOpers); ++i) {
+			const impl::cpu::CpuOperatorEntry<T>& entry = entries[i];
+			if ((oper == OPER_NONE || entry.operation == oper) && entry.details.matches(details, matchAnyDetails)) {
+				result.push_back(entry.create());
+				operCount++;
+			}
+		}
+	}
 
+protected:
+	/** The operator table searched by getDetails() and filterOperators(). */
+	virtual const impl::cpu::CpuOperatorEntry<T>* operatorEntries(size_t& size) const = 0;
+
+private:
+	AbstractCpuImplementation(const AbstractCpuImplementation<T>&);
+	AbstractCpuImplementation<T>& operator=(const AbstractCpuImplementation<T>&);
+
+	impl::cpu::CpuThreadPool* _pool;
+	impl::cpu::CpuAllocator* _allocator;
+	bool _ownsAllocator;
+};
+
+
+/**
+ * The CPU implementation, operating on full matrices.
+ */
+template <typename T> class CpuImplementation : public AbstractCpuImplementation<T> {
+public:
+	explicit CpuImplementation(size_t numThreads = 1, impl::cpu::CpuAllocator* allocator = NULL) :
+		AbstractCpuImplementation<T>(numThreads, allocator) {}
+
+
+	EImplementation type() const {
+		return IMPL_CPU;
 	}
 
 
-	void filterOperators(std::vector<IOperator<T>*>& result, size_t maxOpers = 0, EOperation oper = OPER_NONE, OperationDetails details = 0, bool matchAnyDetails = false) const {
-		// TODO Implementation
+	CpuState<T>* newState() const {
+		return new CpuState<T>(this);
+	}
+
+protected:
+	const impl::cpu::CpuOperatorEntry<T>* operatorEntries(size_t& size) const {
+		return impl::cpu::cpuOperators<T>(size);
 	}
 };
 
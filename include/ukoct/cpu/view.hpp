@@ -0,0 +1,62 @@
+#ifndef UKOCT_CPU_VIEW_HPP_
+#define UKOCT_CPU_VIEW_HPP_
+
+#include "plas.hpp"
+
+namespace ukoct {
+namespace impl {
+namespace cpu {
+
+/**
+ * Non-owning, unchecked view of a square matrix with a fixed ordering.
+ *
+ * Indices are 0-based, so the switched index of i is i ^ 1. Unlike
+ * plas::DenseMatrix::operator(), accessing an element is a single
+ * multiply-add, with no bounds, ordering or resizing checks.
+ *
+ * Many operators are indifferent to the ordering of their matrix, as their
+ * result for the transposed matrix is the transpose of their result. Those
+ * may use a row-major view regardless of the actual ordering; the others
+ * must dispatch on it (see CpuState::rowMajor()).
+ *
+ * Rows (or columns) are `pitch` elements apart, which may be more than the
+ * size of the matrix (see CpuState::pitch()).
+ */
+template <typename T, plas::EMatrixOrdering O = plas::MATRIX_ROWMAJOR> class CpuMatrixView {
+public:
+	CpuMatrixView(T* data, size_t n, size_t pitch) :
+		_data(data),
+		_n(n),
+		_pitch(pitch) {}
+
+
+	inline size_t size() const {
+		return _n;
+	}
+
+
+	inline size_t pitch() const {
+		return _pitch;
+	}
+
+
+	inline T* raw() const {
+		return _data;
+	}
+
+
+	inline T& operator()(size_t i, size_t j) const {
+		return O == plas::MATRIX_COLMAJOR ? _data[j * _pitch + i] : _data[i * _pitch + j];
+	}
+
+private:
+	T* _data;
+	size_t _n;
+	size_t _pitch;
+};
+
+}
+}
+}
+
+#endif /* UKOCT_CPU_VIEW_HPP_ */
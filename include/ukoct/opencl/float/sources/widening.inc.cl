@@ -0,0 +1,41 @@
+ukoct_STRFY(
+
+		
+__kernel
+void octdiff_widening__global(
+	__const  int    nvars,
+	__global float* self,
+	__const  int    self_rowmajor,
+	__global float* other,
+	__const  int    other_rowmajor,
+	__global float* thresholds,
+	__const  int    nthresholds
+) {
+	const int g_i = get_global_id(0);
+	const int g_j = get_global_id(1);
+
+	const int gs_ij = idx(self_rowmajor,  nvars,    g_i,     g_j);
+	const int go_ij = idx(other_rowmajor, nvars,    g_i,     g_j);
+
+	float v_ij = self[gs_ij];
+	float o_ij = other[go_ij];
+
+	// Growing bounds go to the first threshold not below them (binary search), or infinity
+	if (o_ij > v_ij) {
+		int lo = 0;
+		int hi = nthresholds;
+		while (lo < hi) {
+			int mid = (lo + hi) >> 1;
+			if (thresholds[mid] < o_ij)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		v_ij = (lo < nthresholds) ? thresholds[lo] : INFINITY;
+	}
+
+	self[gs_ij] = v_ij;
+}
+
+
+)
@@ -19,7 +19,7 @@
 #define RETUNDEF   30
 #define RETTIMEOUT 40
 
-#define ukoct_AVAILABLE_IMPL "cpu, opencl"
+#define ukoct_AVAILABLE_IMPL "cpu, cpuhalf, opencl"
 
 #define OVERVIEWTEXT ukoct_BRIEF
 
@@ -28,11 +28,18 @@ const TypeName operNames[ukoct::OPER_MAX_ + 1] {
 	, { ukoct::OPER_PUSHDIFFCONS    , "pushd" }
 	, { ukoct::OPER_PUSHOCTCONS     , "pushc" }
 	, { ukoct::OPER_FORGETOCTVAR    , "pop" }
+	, { ukoct::OPER_INCCLOSURE      , "inccl" }
 
 	, { ukoct::OPER_EQUALS          , "eq" }
 	, { ukoct::OPER_INCLUDES        , "inc" }
 	, { ukoct::OPER_UNION           , "and" }
 	, { ukoct::OPER_INTERSECTION    , "or" }
+	, { ukoct::OPER_WIDENING        , "widen" }
+	, { ukoct::OPER_NARROWING       , "narrow" }
+
+	, { ukoct::OPER_REMOVEDIMS      , "rmdims" }
+	, { ukoct::OPER_ADDDIMS         , "adddims" }
+	, { ukoct::OPER_PERMUTEDIMS     , "permdims" }
 };
 
 
@@ -41,14 +48,17 @@ const TypeName elemNames[ukoct::ELEM_MAX_ + 1] = {
 	{ ukoct::ELEM_HALF   , "half"      },
 	{ ukoct::ELEM_FLOAT  , "float"     },
 	{ ukoct::ELEM_DOUBLE , "double"    },
-	{ ukoct::ELEM_LDOUBLE, "ldouble"   }
+	{ ukoct::ELEM_LDOUBLE, "ldouble"   },
+	{ ukoct::ELEM_INT32  , "int32"     },
+	{ ukoct::ELEM_INT64  , "int64"     }
 };
 
 
 const TypeName implNames[ukoct::IMPL_MAX_ + 1] = {
 	{ ukoct::IMPL_NONE  , NULL        },
 	{ ukoct::IMPL_CPU   , "cpu"       },
-	{ ukoct::IMPL_OPENCL, "opencl"    }
+	{ ukoct::IMPL_OPENCL, "opencl"    },
+	{ ukoct::IMPL_CPUHALF, "cpuhalf"  }
 };
 
 
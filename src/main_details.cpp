@@ -65,6 +65,7 @@ private:
 
 		switch(A.implType) {
 		case ukoct::IMPL_CPU:
+		case ukoct::IMPL_CPUHALF:
 		{
 
 		}
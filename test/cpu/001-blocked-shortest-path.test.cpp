@@ -0,0 +1,38 @@
+#include "common.hpp"
+
+
+/* The blocked variant is picked by asking for local memory, and finds the same shortest paths as Floyd-Warshall. */
+void blocked(size_t n, double density, bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	ukoct::IOperator<double>* op = impl.newOperator(ukoct::OPER_SHORTESTPATH, ukoct::O_MEM_LOCAL);
+	test::check(op != NULL && (op->details() & ukoct::O_MEM_LOCAL) != 0, "blocked variant not found");
+	delete op;
+
+	for (int round = 0; round < 10; ++round) {
+		// Some negative entries, so some of the matrices have negative cycles
+		std::vector<double> m = test::randomDbm<double>(n, density, -1, 20, round % 2 == 0);
+		std::vector<double> expected(m);
+		bool consistent = test::shortestPath(expected, n);
+
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		ukoct::OperatorArgs<double> args(*state);
+		bool result = test::run(impl, ukoct::OPER_SHORTESTPATH, args, ukoct::O_MEM_LOCAL);
+		test::check(result == consistent, "consistency");
+		if (result && consistent)
+			test::check(test::matrix(*state) == expected, "shortest paths");
+		delete state;
+	}
+}
+
+
+int main(void) {
+	srand(1);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		// 4 variables make a single tile, the others several, with a remainder
+		blocked(8, 0.5, rowMajor);
+		blocked(70, 0.1, rowMajor);
+		blocked(70, 0.02, rowMajor);
+		blocked(136, 0.05, rowMajor);
+	}
+	return test::result();
+}
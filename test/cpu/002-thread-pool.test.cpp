@@ -0,0 +1,86 @@
+#include <atomic>
+#include <stdexcept>
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuThreadPool;
+
+
+/* Every worker runs each task once, in phases separated by the barrier, and errors reach the caller. */
+void pool() {
+	CpuThreadPool pool(4);
+	test::check(pool.size() == 4 && pool.barrier().count() == 4, "pool size");
+
+	std::vector<int> items(103, 0);
+	std::atomic<size_t> calls(0);
+	std::atomic<size_t> late(0);
+	std::atomic<size_t> phase(0);
+	for (int round = 0; round < 3; ++round) {
+		pool.run([&](size_t worker, size_t numWorkers) {
+			size_t begin, end;
+			CpuThreadPool::range(items.size(), worker, numWorkers, begin, end);
+			for (size_t i = begin; i < end; ++i)
+				++items[i];
+			++calls;
+			++phase;
+			pool.barrier().wait();
+			if (phase != 4 * size_t(round + 1))
+				++late;
+			pool.barrier().wait();
+		});
+	}
+	test::check(calls == 12, "workers run once per task");
+	test::check(late == 0, "barrier let a worker through early");
+	bool covered = true;
+	for (size_t i = 0; i < items.size(); ++i)
+		covered = covered && items[i] == 3;
+	test::check(covered, "ranges cover every item once");
+
+	bool thrown = false;
+	try {
+		pool.run([&](size_t worker, size_t numWorkers) {
+			if (worker == numWorkers - 1)
+				throw std::runtime_error("worker error");
+		});
+	} catch (std::runtime_error&) {
+		thrown = true;
+	}
+	test::check(thrown, "worker error not rethrown");
+
+	calls = 0;
+	pool.run([&](size_t worker, size_t numWorkers) { ++calls; });
+	test::check(calls == 4, "pool unusable after an error");
+}
+
+
+/* Closures of 4-variable and larger DBMs are the same with and without a pool. */
+void closure(size_t n, double density, bool rowMajor) {
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	test::check(!sequential.parallel(n) && parallel.parallel(n) == (n >= ukoct_CPU_PARALLELSIZE), "parallel threshold");
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, density, -1, 20, true);
+		for (int operation = 0; operation < 2; ++operation) {
+			ukoct::EOperation oper = operation == 0 ? ukoct::OPER_SHORTESTPATH : ukoct::OPER_CLOSURE;
+			ukoct::CpuState<double>* a = test::newState(sequential, m, rowMajor);
+			ukoct::CpuState<double>* b = test::newState(parallel, m, rowMajor);
+			bool consistent = test::run(sequential, oper, *a);
+			test::check(test::run(parallel, oper, *b) == consistent, "parallel consistency");
+			if (consistent)
+				test::check(test::matrix(*a) == test::matrix(*b), "parallel closure");
+			delete a;
+			delete b;
+		}
+	}
+}
+
+
+int main(void) {
+	srand(2);
+	pool();
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		closure(8, 0.5, rowMajor);
+		closure(96, 0.05, rowMajor);
+	}
+	return test::result();
+}
@@ -0,0 +1,111 @@
+#include <cstdlib>
+#include <limits>
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuKernels;
+using ukoct::impl::cpu::ScalarCpuKernels;
+
+
+/* Runs some kernels and the scalar ones on the same rows, of lengths which leave remainders for any vector width. */
+template <typename T> void kernels(const CpuKernels<T>& simd) {
+	const CpuKernels<T>& scalar = ScalarCpuKernels<T>::kernels();
+	T inf = ukoct::ElemTypeInfo<T>::infinity();
+	std::cout << "Kernels: " << simd.isa << std::endl;
+
+	for (size_t n = 1; n < 70; n += 3) {
+		std::vector<T> a(n), b(n), c(n), d(n);
+		for (size_t j = 0; j < n; ++j) {
+			a[j] = rand() % 5 == 0 ? inf : T(rand() % 41 - 20);
+			b[j] = rand() % 5 == 0 ? inf : T(rand() % 41 - 20);
+			c[j] = T(rand() % 41 - 20);
+		}
+
+		std::vector<T> x(c), y(c);
+		simd.relaxPair(&x[0], &a[0], &b[0], 3, -2, n);
+		scalar.relaxPair(&y[0], &a[0], &b[0], 3, -2, n);
+		test::check(x == y, "relaxPair");
+
+		x = c; y = c;
+		simd.strengthen(&x[0], &a[0], 4, n);
+		scalar.strengthen(&y[0], &a[0], 4, n);
+		test::check(x == y, "strengthen");
+
+		simd.min(&x[0], &a[0], &b[0], n);
+		scalar.min(&y[0], &a[0], &b[0], n);
+		test::check(x == y, "min");
+
+		simd.max(&x[0], &a[0], &b[0], n);
+		scalar.max(&y[0], &a[0], &b[0], n);
+		test::check(x == y, "max");
+
+		simd.widen(&x[0], &a[0], &b[0], inf, n);
+		scalar.widen(&y[0], &a[0], &b[0], inf, n);
+		test::check(x == y, "widen");
+
+		simd.narrow(&x[0], &a[0], &b[0], inf, n);
+		scalar.narrow(&y[0], &a[0], &b[0], inf, n);
+		test::check(x == y, "narrow");
+
+		test::check(simd.equal(&a[0], &a[0], n) && simd.equal(&a[0], &b[0], n) == scalar.equal(&a[0], &b[0], n), "equal");
+		test::check(simd.lessEqual(&a[0], &b[0], n) == scalar.lessEqual(&a[0], &b[0], n), "lessEqual");
+	}
+}
+
+
+/* The kernels of every instruction set the processor supports, not only the dispatched ones. */
+template <typename T> void kernels() {
+	const std::vector<const CpuKernels<T>*>& supported = CpuKernels<T>::supported();
+	test::check(!supported.empty() && supported.front() == &CpuKernels<T>::get(), "dispatched kernels");
+	test::check(supported.back() == &ScalarCpuKernels<T>::kernels(), "scalar kernels");
+	for (size_t k = 0; k < supported.size(); ++k)
+		kernels(*supported[k]);
+}
+
+
+/* Union and intersection of states of different orderings combine the same cells. */
+void orderings() {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	std::vector<double> a(n * n), b(n * n);
+	for (size_t i = 0; i < n * n; ++i) {
+		a[i] = double(i % 7);
+		b[i] = double((i * 5) % 11);
+	}
+
+	for (int rowMajorA = 0; rowMajorA < 2; ++rowMajorA) {
+		for (int rowMajorB = 0; rowMajorB < 2; ++rowMajorB) {
+			for (int dest = 0; dest < 3; ++dest) {
+				for (int join = 0; join < 2; ++join) {
+					ukoct::CpuState<double>* sa = test::newState(impl, a, rowMajorA);
+					ukoct::CpuState<double>* sb = test::newState(impl, b, rowMajorB);
+					ukoct::CpuState<double>* sd = impl.newState();
+					ukoct::IState<double>* target = dest == 0 ? sa : dest == 1 ? sb : sd;
+					ukoct::OperatorArgs<double> args(*sa);
+					args.other(sb);
+					args.dest(target);
+					test::run(impl, join ? ukoct::OPER_UNION : ukoct::OPER_INTERSECTION, args);
+
+					std::vector<double> m = test::matrix(*target);
+					bool same = true;
+					for (size_t i = 0; i < n * n; ++i)
+						same = same && m[i] == (join ? std::max(a[i], b[i]) : std::min(a[i], b[i]));
+					test::check(same, join ? "union of mixed orderings" : "intersection of mixed orderings");
+					delete sa;
+					delete sb;
+					delete sd;
+				}
+			}
+		}
+	}
+}
+
+
+int main(void) {
+	srand(3);
+	kernels<float>();
+	kernels<double>();
+	kernels<int32_t>();
+	kernels<int64_t>();
+	orderings();
+	return test::result();
+}
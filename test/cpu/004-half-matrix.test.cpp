@@ -0,0 +1,94 @@
+#include "common.hpp"
+
+
+/* Runs an operation on full and half-matrix states of the same coherent DBMs, and compares the results. */
+void operation(ukoct::EOperation operation, const ukoct::IImplementation<double>& full, const ukoct::IImplementation<double>& half, size_t n, bool rowMajor, bool closed) {
+	for (int round = 0; round < 10; ++round) {
+		double density = n > 8 ? 0.05 : 0.5;
+		std::vector<double> m = test::randomDbm<double>(n, density, -1, 20, true);
+		std::vector<double> o = test::randomDbm<double>(n, density, -1, 20, true);
+		if (closed) {
+			test::shortestPath(m, n);
+			test::strengthen(m, n);
+		}
+		plas::var_t var = rand() % (n / 2) + 1;
+		plas::OctDiffConstraint<double> cons(rand() % n + 1, rand() % n + 1, double(rand() % 10));
+		bool intBased = rand() % 2 == 0;
+
+		std::vector<double> results[2];
+		bool boolResults[2];
+		for (int h = 0; h < 2; ++h) {
+			const ukoct::IImplementation<double>& impl = h == 0 ? full : half;
+			ukoct::IState<double>* state = impl.newState();
+			ukoct::IState<double>* other = impl.newState();
+			state->setup(n, &m[0], rowMajor);
+			other->setup(n, &o[0], !rowMajor);
+			ukoct::OperatorArgs<double> args(*state);
+			args.other(other);
+			args.var(var);
+			args.diffCons(cons);
+			args.intBased(intBased);
+			boolResults[h] = test::run(impl, operation, args);
+			// Half-matrix states push the coherent counterpart of the constraint along with it
+			if (operation == ukoct::OPER_PUSHDIFFCONS && h == 0) {
+				args.diffCons(plas::OctDiffConstraint<double>(((cons.b() - 1) ^ 1) + 1, ((cons.a() - 1) ^ 1) + 1, cons.d()));
+				test::run(impl, operation, args);
+			}
+			results[h] = test::matrix(*state);
+			delete state;
+			delete other;
+		}
+
+		// Closures stop as soon as they find a negative cycle, leaving the states partially closed
+		bool closes = operation == ukoct::OPER_CLOSURE || operation == ukoct::OPER_TIGHTCLOSURE || operation == ukoct::OPER_SHORTESTPATH
+				|| operation == ukoct::OPER_INCCLOSURE || operation == ukoct::OPER_PUSHDIFFCONS;
+		bool consistent = boolResults[0];
+		for (size_t i = 0; i < n; ++i)
+			consistent = consistent && results[0][i * n + i] >= 0;
+		test::check(boolResults[0] == boolResults[1], "half-matrix result");
+		if (!closes || consistent)
+			test::check(results[0] == results[1], "half-matrix state");
+	}
+}
+
+
+/* Half-matrix states keep the tightest of the two coherent entries. */
+void setup() {
+	ukoct::CpuHalfImplementation<double> half;
+	size_t n = 8;
+	std::vector<double> m = test::randomDbm<double>(n, 0.7, 0, 9, false);
+	ukoct::IState<double>* state = half.newState();
+	state->setup(n, &m[0], true);
+	std::vector<double> r = test::matrix(*state);
+	bool tightest = true;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			tightest = tightest && r[i * n + j] == std::min(m[i * n + j], m[(j ^ 1) * n + (i ^ 1)]);
+	test::check(tightest, "half-matrix setup");
+	test::check(ukoct::CpuHalfState<double>::packedSize(n) == n * n / 2 + n, "half-matrix size");
+	delete state;
+}
+
+
+int main(void) {
+	srand(4);
+	ukoct::EOperation operations[] = {
+		ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISINTCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISTOP,
+		ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE, ukoct::OPER_SHORTESTPATH, ukoct::OPER_STRENGTHEN, ukoct::OPER_TIGHTEN, ukoct::OPER_TOP,
+		ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_FORGETOCTVAR, ukoct::OPER_INCCLOSURE,
+		ukoct::OPER_EQUALS, ukoct::OPER_INCLUDES, ukoct::OPER_UNION, ukoct::OPER_INTERSECTION
+	};
+
+	ukoct::CpuImplementation<double> full;
+	ukoct::CpuHalfImplementation<double> half;
+	ukoct::CpuHalfImplementation<double> parallelHalf(4);
+	for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+		bool closed = operations[k] == ukoct::OPER_INCCLOSURE || operations[k] == ukoct::OPER_PUSHDIFFCONS;
+		for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+			operation(operations[k], full, half, 8, rowMajor, closed);
+			operation(operations[k], full, parallelHalf, 80, rowMajor, closed);
+		}
+	}
+	setup();
+	return test::result();
+}
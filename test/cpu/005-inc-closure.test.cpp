@@ -0,0 +1,68 @@
+#include "common.hpp"
+
+
+/* Sets m[ab] and its coherent counterpart m[BA] to d where tighter, for a row-major n x n matrix and a 1-based constraint. */
+void push(std::vector<double>& m, size_t n, const plas::OctDiffConstraint<double>& c) {
+	size_t a = c.a() - 1;
+	size_t b = c.b() - 1;
+	m[a * n + b] = std::min(m[a * n + b], c.d());
+	m[(b ^ 1) * n + (a ^ 1)] = std::min(m[(b ^ 1) * n + (a ^ 1)], c.d());
+}
+
+
+/* Pushing a constraint to a closed DBM gives the same as closing it (or tightly closing it) again from scratch. */
+void incremental(ukoct::CpuImplementation<double>& impl, size_t n, bool rowMajor, bool intBased, bool octagonal) {
+	for (int round = 0; round < 20; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, n > 8 ? 0.05 : 0.4, 0, 20, true);
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		ukoct::OperatorArgs<double> args(*state);
+		args.intBased(intBased);
+		test::run(impl, ukoct::OPER_CLOSURE, args);
+		std::vector<double> closed = test::matrix(*state);
+
+		// Negative bounds make some of the results inconsistent
+		plas::var_t octSize = plas::var_t(n / 2);
+		plas::OctDiffConstraint<double> ca(rand() % n + 1, rand() % n + 1, double(rand() % 20 - 8));
+		plas::OctDiffConstraint<double> cb;
+		plas::OctConstraint<double> f;
+		if (octagonal) {
+			plas::var_t a = rand() % octSize + 1;
+			plas::var_t b = rand() % 4 == 0 ? a : (a + rand() % (octSize - 1)) % octSize + 1;
+			f = plas::OctConstraint<double>(rand() % 2 ? a : -a, a == b || rand() % 2 ? b : -b, double(rand() % 20 - 8));
+			plas::OctConstraint<double>(f).split(ca, cb);
+		}
+		push(closed, n, ca);
+		if (cb.valid())
+			push(closed, n, cb);
+
+		// Int-based, the result is tightened as the tight closure does
+		ukoct::CpuState<double>* expected = test::newState(impl, closed, rowMajor);
+		bool consistent = test::run(impl, intBased ? ukoct::OPER_TIGHTCLOSURE : ukoct::OPER_CLOSURE, *expected);
+
+		if (octagonal)
+			args.octCons(f);
+		else
+			args.diffCons(ca);
+		test::check(test::run(impl, ukoct::OPER_INCCLOSURE, args) == consistent, "incremental closure consistency");
+		if (consistent)
+			test::check(test::matrix(*state) == test::matrix(*expected), "incremental closure");
+		delete state;
+		delete expected;
+	}
+}
+
+
+int main(void) {
+	srand(5);
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		for (int intBased = 0; intBased < 2; ++intBased) {
+			for (int octagonal = 0; octagonal < 2; ++octagonal) {
+				incremental(sequential, 8, rowMajor, intBased, octagonal);
+				incremental(parallel, 80, rowMajor, intBased, octagonal);
+			}
+		}
+	}
+	return test::result();
+}
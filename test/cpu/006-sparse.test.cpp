@@ -0,0 +1,75 @@
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuPivotIndex;
+
+
+/* Relaxing through an index of sparse or dense pivot rows gives the same as the plain loop. */
+void pivots() {
+	double inf = std::numeric_limits<double>::infinity();
+
+	for (size_t n = 8; n < 100; n += 13) {
+		for (int round = 0; round < 20; ++round) {
+			double density = round % 2 == 0 ? 0.05 : 0.8;
+			std::vector<double> rk(n), rK(n), row(n);
+			size_t finite = 0;
+			for (size_t j = 0; j < n; ++j) {
+				rk[j] = rand() < density * RAND_MAX ? double(rand() % 20) : inf;
+				rK[j] = rand() < density * RAND_MAX ? double(rand() % 20) : inf;
+				row[j] = rand() % 2 ? double(rand() % 30) : inf;
+				if (rk[j] < inf || rK[j] < inf)
+					++finite;
+			}
+			double ik = round % 5 == 0 ? inf : double(rand() % 10);
+			double iK = round % 3 == 0 ? inf : double(rand() % 10);
+
+			CpuPivotIndex<double> index(n, inf);
+			index.build(&rk[0], &rK[0], n);
+			test::check(index.count() == finite, "finite pivot columns");
+			test::check(index.sparse() == (finite < ukoct_CPU_SPARSEDENSITY * n), "sparse pivots");
+			test::check(index.reaches(ik, iK) == (finite > 0 && (ik < inf || iK < inf)), "pivots reached");
+
+			std::vector<double> expected(row);
+			for (size_t j = 0; j < n; ++j)
+				expected[j] = std::min(expected[j], std::min(ik + rk[j], iK + rK[j]));
+			index.relax(&row[0], &rk[0], &rK[0], ik, iK, n);
+			test::check(row == expected, "pivot relaxation");
+		}
+	}
+}
+
+
+/* Closures of sparse DBMs, 4-variable ones and larger ones, match Floyd-Warshall. */
+void closure(size_t n, double density, bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	ukoct::CpuHalfImplementation<double> half;
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, density, -1, 20, true);
+		std::vector<double> expected(m);
+		bool consistent = test::shortestPath(expected, n);
+
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		ukoct::IState<double>* halfState = half.newState();
+		test::setup(*halfState, m, rowMajor);
+		test::check(test::run(impl, ukoct::OPER_SHORTESTPATH, *state) == consistent, "sparse consistency");
+		test::check(test::run(half, ukoct::OPER_SHORTESTPATH, *halfState) == consistent, "sparse half-matrix consistency");
+		if (consistent) {
+			test::check(test::matrix(*state) == expected, "sparse closure");
+			test::check(test::matrix(*halfState) == expected, "sparse half-matrix closure");
+		}
+		delete state;
+		delete halfState;
+	}
+}
+
+
+int main(void) {
+	srand(6);
+	pivots();
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		closure(8, 0.15, rowMajor);
+		closure(120, 0.01, rowMajor);
+		closure(120, 0.04, rowMajor);
+	}
+	return test::result();
+}
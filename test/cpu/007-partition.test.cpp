@@ -0,0 +1,140 @@
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuPartition;
+
+
+/* A random coherent DBM whose variables are split into `groups` independent groups, given in `group`. */
+std::vector<double> blockDbm(size_t n, size_t groups, std::vector<size_t>& group, bool consistent) {
+	std::vector<double> m = test::randomDbm<double>(n, 0.6, consistent ? 0 : -1, 20, true);
+	group.resize(n / 2);
+	for (size_t v = 0; v < group.size(); ++v)
+		group[v] = rand() % groups;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (group[i / 2] != group[j / 2])
+				m[i * n + j] = std::numeric_limits<double>::infinity();
+	return m;
+}
+
+
+/* Whether the partition relates all the variables a finite entry relates. */
+bool covers(CpuPartition& partition, const std::vector<double>& m, size_t n) {
+	if (!partition.valid() || partition.size() != n / 2)
+		return false;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (m[i * n + j] < std::numeric_limits<double>::infinity() && partition.find(i / 2) != partition.find(j / 2))
+				return false;
+	return true;
+}
+
+
+/* Building, merging and listing the components of a 4-variable partition. */
+void partition() {
+	double inf = std::numeric_limits<double>::infinity();
+	size_t n = 8;
+	std::vector<double> m(n * n, inf);
+	for (size_t i = 0; i < n; ++i)
+		m[i * n + i] = 0;
+	m[0 * n + 5] = 1; // Relates variables 0 and 2
+	m[6 * n + 7] = 2; // Bounds variable 3
+
+	CpuPartition p;
+	test::check(!p.valid(), "partitions start unknown");
+	p.merge(0, 1);
+	test::check(!p.valid(), "merging into an unknown partition");
+	p.build(&m[0], n, n, inf);
+	test::check(p.valid() && p.size() == 4, "built partition");
+	test::check(p.find(0) == p.find(2) && p.find(0) != p.find(1) && p.find(1) != p.find(3), "built components");
+
+	std::vector<std::vector<size_t> > components;
+	p.components(components);
+	test::check(components.size() == 3 && components[0].size() == 4, "largest component first");
+	test::check(components[0][0] == 0 && components[0][1] == 1 && components[0][2] == 4 && components[0][3] == 5, "component indices");
+
+	// Strengthening relates all variables with unary bounds
+	m[2 * n + 3] = 4;
+	p.mergeBounded(&m[0], n, inf);
+	test::check(p.find(1) == p.find(3) && p.find(0) != p.find(1), "bounded variables merged");
+
+	CpuPartition q;
+	q.reset(4);
+	q.merge(2, 3);
+	p.merge(q);
+	test::check(p.find(0) == p.find(1), "merged partitions");
+	q.invalidate();
+	p.merge(q);
+	test::check(!p.valid(), "merging an unknown partition");
+}
+
+
+/* Block-diagonal DBMs are closed component by component, with the same results as a global closure. */
+void closure(ukoct::CpuImplementation<double>& impl, size_t n, size_t groups, bool rowMajor) {
+	for (int round = 0; round < 10; ++round) {
+		std::vector<size_t> group;
+		std::vector<double> m = blockDbm(n, groups, group, round % 3 != 0);
+		std::vector<double> expected(m);
+		bool consistent = test::shortestPath(expected, n);
+		test::strengthen(expected, n);
+
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		test::check(test::run(impl, ukoct::OPER_CLOSURE, *state) == consistent, "consistency of components");
+		if (consistent) {
+			test::check(test::matrix(*state) == expected, "closure of components");
+			test::check(test::run(impl, ukoct::OPER_ISCLOSED, *state), "closure of components not closed");
+		}
+		delete state;
+	}
+}
+
+
+/* Operators keep the partition up to date, or have it rebuilt. */
+void operators(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	ukoct::EOperation operations[] = {
+		ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_PUSHOCTCONS, ukoct::OPER_INCCLOSURE, ukoct::OPER_STRENGTHEN, ukoct::OPER_TIGHTEN,
+		ukoct::OPER_FORGETOCTVAR, ukoct::OPER_TOP, ukoct::OPER_COPY, ukoct::OPER_UNION, ukoct::OPER_INTERSECTION,
+		ukoct::OPER_WIDENING, ukoct::OPER_NARROWING, ukoct::OPER_CLOSURE
+	};
+
+	for (int round = 0; round < 20; ++round) {
+		std::vector<size_t> group, otherGroup;
+		std::vector<double> m = blockDbm(n, 3, group, true);
+		std::vector<double> o = blockDbm(n, 3, otherGroup, true);
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		ukoct::CpuState<double>* other = test::newState(impl, o, rowMajor);
+		test::run(impl, ukoct::OPER_CLOSURE, *state);
+
+		for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+			state->partition(true);
+			ukoct::OperatorArgs<double> args(*state);
+			args.other(other);
+			args.var(rand() % (n / 2) + 1);
+			args.diffCons(plas::OctDiffConstraint<double>(rand() % n + 1, rand() % n + 1, double(rand() % 10)));
+			args.octCons(plas::OctConstraint<double>(rand() % (n / 2) + 1, -plas::var_t(rand() % (n / 2) + 1), double(rand() % 10)));
+			test::run(impl, operations[k], args);
+			if (state->partition(false).valid())
+				test::check(covers(state->partition(false), test::matrix(*state), n), "partition kept up to date");
+			test::check(covers(state->partition(true), test::matrix(*state), n), "partition rebuilt");
+		}
+		delete state;
+		delete other;
+	}
+}
+
+
+int main(void) {
+	srand(7);
+	partition();
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		closure(sequential, 8, 2, rowMajor);
+		closure(sequential, 40, 4, rowMajor);
+		closure(parallel, 100, 6, rowMajor);
+		closure(parallel, 100, 1, rowMajor);
+		operators(rowMajor);
+	}
+	return test::result();
+}
@@ -0,0 +1,43 @@
+#include "common.hpp"
+
+
+/* The fused variant is picked by asking for a single pass, and closes DBMs as the default closure does. */
+void fused(ukoct::CpuImplementation<double>& impl, size_t n, double density, bool rowMajor) {
+	ukoct::IOperator<double>* op = impl.newOperator(ukoct::OPER_CLOSURE, ukoct::O_EXEC_ONEPASS);
+	test::check(op != NULL && (op->details() & ukoct::O_EXEC_ONEPASS) != 0, "fused variant not found");
+	delete op;
+
+	for (int round = 0; round < 20; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, density, round % 2 == 0 ? -1 : -6, 20, true);
+		bool intBased = round % 4 == 0;
+		ukoct::CpuState<double>* expected = test::newState(impl, m, rowMajor);
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		ukoct::OperatorArgs<double> expectedArgs(*expected);
+		ukoct::OperatorArgs<double> args(*state);
+		expectedArgs.intBased(intBased);
+		args.intBased(intBased);
+
+		bool consistent = test::run(impl, ukoct::OPER_CLOSURE, expectedArgs);
+		test::check(test::run(impl, ukoct::OPER_CLOSURE, args, ukoct::O_EXEC_ONEPASS) == consistent, "fused consistency");
+		if (consistent) {
+			test::check(test::matrix(*state) == test::matrix(*expected), "fused closure");
+			if (!intBased)
+				test::check(state->flags().holds(ukoct::impl::cpu::CPUSTATE_STRONGLYCLOSED), "fused closure not known strongly closed");
+		}
+		delete state;
+		delete expected;
+	}
+}
+
+
+int main(void) {
+	srand(8);
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		fused(sequential, 8, 0.5, rowMajor);
+		fused(sequential, 40, 0.1, rowMajor);
+		fused(parallel, 90, 0.05, rowMajor);
+	}
+	return test::result();
+}
@@ -0,0 +1,91 @@
+#include "common.hpp"
+
+
+/* Every closure, in every implementation and path, reports negative cycles. */
+void consistency(ukoct::CpuImplementation<double>& impl, ukoct::CpuHalfImplementation<double>& half, size_t n, double density, bool rowMajor) {
+	ukoct::EOperation operations[] = { ukoct::OPER_SHORTESTPATH, ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE };
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, density, -4, 20, true);
+		std::vector<double> expected(m);
+		bool consistent = test::shortestPath(expected, n);
+
+		for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+			for (int variant = 0; variant < 3; ++variant) {
+				// The default operators, their variants, and the half-matrix ones
+				ukoct::OperationDetails details = 0;
+				if (variant == 1 && operations[k] == ukoct::OPER_TIGHTCLOSURE)
+					continue;
+				else if (variant == 1)
+					details = operations[k] == ukoct::OPER_SHORTESTPATH ? ukoct::O_MEM_LOCAL : ukoct::O_EXEC_ONEPASS;
+
+				const ukoct::IImplementation<double>& i = variant == 2 ? static_cast<const ukoct::IImplementation<double>&>(half) : impl;
+				ukoct::IState<double>* state = i.newState();
+				test::setup(*state, m, rowMajor);
+				bool result = test::run(i, operations[k], ukoct::OperatorArgs<double>(*state), details);
+				// Tight closures check integer consistency
+				if (operations[k] != ukoct::OPER_TIGHTCLOSURE || !consistent)
+					test::check(result == consistent, "negative cycle");
+				delete state;
+			}
+		}
+	}
+}
+
+
+/*
+ * A negative cycle through the first variable of a 4-variable DBM stops the
+ * closure before the paths through the last one are found, and the result
+ * is remembered.
+ */
+void early(bool rowMajor) {
+	double inf = std::numeric_limits<double>::infinity();
+	size_t n = 8;
+	std::vector<double> m(n * n, inf);
+	for (size_t i = 0; i < n; ++i)
+		m[i * n + i] = 0;
+	m[0 * n + 1] = -1;
+	m[1 * n + 0] = -1;
+	m[4 * n + 6] = 1;
+	m[6 * n + 7] = 1;
+	// Relates all the variables, so that they're closed together
+	m[0 * n + 2] = 5;
+	m[2 * n + 4] = 5;
+	m[4 * n + 0] = 5;
+
+	ukoct::CpuImplementation<double> impl;
+	ukoct::CpuHalfImplementation<double> half;
+	ukoct::EOperation operations[] = { ukoct::OPER_SHORTESTPATH, ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE };
+	for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+		for (int h = 0; h < 2; ++h) {
+			const ukoct::IImplementation<double>& i = h == 0 ? static_cast<const ukoct::IImplementation<double>&>(impl) : half;
+			ukoct::IState<double>* state = i.newState();
+			test::setup(*state, m, rowMajor);
+			test::check(!test::run(i, operations[k], *state), "negative cycle not found");
+			test::check(test::matrix(*state)[4 * n + 7] == inf, "closure went on after a negative cycle");
+			delete state;
+		}
+	}
+
+	ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+	test::run(impl, ukoct::OPER_CLOSURE, *state);
+	test::check(state->flags().fails(ukoct::impl::cpu::CPUSTATE_CONSISTENT), "inconsistency not remembered");
+	test::check(!test::run(impl, ukoct::OPER_ISCONSISTENT, *state), "remembered inconsistency");
+	delete state;
+}
+
+
+int main(void) {
+	srand(9);
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	ukoct::CpuHalfImplementation<double> half;
+	ukoct::CpuHalfImplementation<double> parallelHalf(4);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		consistency(sequential, half, 8, 0.4, rowMajor);
+		consistency(sequential, half, 60, 0.03, rowMajor);
+		consistency(parallel, parallelHalf, 90, 0.05, rowMajor);
+		early(rowMajor);
+	}
+	return test::result();
+}
@@ -0,0 +1,99 @@
+#include "common.hpp"
+
+using namespace ukoct::impl::cpu;
+
+
+/* Whether the flags known for a state hold for its matrix, as checked from scratch by the predicates. */
+bool truthful(ukoct::CpuImplementation<double>& impl, ukoct::CpuState<double>& state) {
+	static const unsigned int flags[] = { CPUSTATE_CONSISTENT, CPUSTATE_COHERENT, CPUSTATE_CLOSED, CPUSTATE_STRONGLYCLOSED, CPUSTATE_TIGHTLYCLOSED };
+	static const ukoct::EOperation predicates[] = { ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISCLOSED, ukoct::OPER_ISSTRONGLYCLOSED, ukoct::OPER_ISTIGHTLYCLOSED };
+	std::vector<double> m = test::matrix(state);
+	bool ok = true;
+
+	for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f) {
+		if (!state.flags().known(flags[f]))
+			continue;
+		ukoct::CpuState<double>* fresh = test::newState(impl, m);
+		ok = ok && state.flags().holds(flags[f]) == test::run(impl, predicates[f], *fresh);
+		delete fresh;
+	}
+	return ok;
+}
+
+
+/* Sequences of operators on 4-variable DBMs never leave flags which don't hold. */
+void sequences(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	ukoct::EOperation operations[] = {
+		ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE, ukoct::OPER_SHORTESTPATH, ukoct::OPER_STRENGTHEN, ukoct::OPER_TIGHTEN,
+		ukoct::OPER_TOP, ukoct::OPER_COPY, ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_PUSHOCTCONS, ukoct::OPER_FORGETOCTVAR,
+		ukoct::OPER_INCCLOSURE, ukoct::OPER_UNION, ukoct::OPER_INTERSECTION, ukoct::OPER_WIDENING, ukoct::OPER_NARROWING,
+		ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISCLOSED, ukoct::OPER_ISSTRONGLYCLOSED, ukoct::OPER_ISTIGHTLYCLOSED,
+		ukoct::OPER_PERMUTEDIMS, ukoct::OPER_ADDDIMS
+	};
+	size_t numOperations = sizeof(operations) / sizeof(operations[0]);
+
+	for (int round = 0; round < 100; ++round) {
+		ukoct::CpuState<double>* state = test::newState(impl, test::randomDbm<double>(n, 0.5, -1, 20, round % 3 != 0), rowMajor);
+		for (int step = 0; step < 12; ++step) {
+			ukoct::EOperation operation = operations[rand() % numOperations];
+			std::vector<plas::var_t> vars;
+			for (plas::var_t v = 1; v <= plas::var_t(state->octSize()); ++v)
+				vars.push_back(v);
+			std::random_shuffle(vars.begin(), vars.end());
+			if (operation == ukoct::OPER_ADDDIMS && state->octSize() >= 6)
+				continue;
+			if (operation == ukoct::OPER_ADDDIMS)
+				vars.assign(1, rand() % (state->octSize() + 1) + 1);
+
+			size_t size = state->diffSize();
+			ukoct::CpuState<double>* other = test::newState(impl, test::randomDbm<double>(size, 0.5, -1, 20, rand() % 2 == 0), rowMajor);
+			if (rand() % 2)
+				test::run(impl, ukoct::OPER_CLOSURE, *other);
+			ukoct::OperatorArgs<double> args(*state);
+			args.other(other);
+			args.intBased(rand() % 4 == 0);
+			args.var(rand() % (size / 2) + 1);
+			args.vars(&vars);
+			args.diffCons(plas::OctDiffConstraint<double>(rand() % size + 1, rand() % size + 1, double(rand() % 10 - 2)));
+			args.octCons(plas::OctConstraint<double>(rand() % (size / 2) + 1, -plas::var_t(rand() % (size / 2) + 1), double(rand() % 10 - 2)));
+			test::run(impl, operation, args);
+
+			if (!truthful(impl, *state)) {
+				std::cout << "After operation " << operation << ":" << std::endl;
+				test::check(false, "flags which don't hold");
+			}
+			delete other;
+		}
+		delete state;
+	}
+}
+
+
+/* Known flags answer predicates and closures without looking at the matrix. */
+void cached() {
+	ukoct::CpuImplementation<double> impl;
+	ukoct::CpuState<double>* state = test::newState(impl, test::randomDbm<double>(8, 0.5, 0, 20, true));
+	test::check(test::run(impl, ukoct::OPER_CLOSURE, *state), "closure");
+	test::check(state->flags().holds(CPUSTATE_CONSISTENT | CPUSTATE_COHERENT | CPUSTATE_CLOSED | CPUSTATE_STRONGLYCLOSED), "closure flags");
+
+	// Writing to the matrix without forgetting the flags goes unnoticed
+	state->input().raw()[1] = -1;
+	state->input().raw()[8] = -1;
+	test::check(test::run(impl, ukoct::OPER_ISSTRONGLYCLOSED, *state), "strong closure not cached");
+	test::check(test::run(impl, ukoct::OPER_CLOSURE, *state), "closure not cached");
+	state->flags().forget();
+	test::check(!test::run(impl, ukoct::OPER_CLOSURE, *state), "closure after forgetting the flags");
+	test::check(state->flags().fails(CPUSTATE_CONSISTENT), "failed closure flags");
+	delete state;
+}
+
+
+int main(void) {
+	srand(10);
+	sequences(true);
+	sequences(false);
+	cached();
+	return test::result();
+}
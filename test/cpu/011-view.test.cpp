@@ -0,0 +1,91 @@
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuMatrixView;
+
+
+/* Views of either ordering address the same logical elements of a padded buffer. */
+void views() {
+	size_t n = 8;
+	size_t pitch = 11;
+	std::vector<double> raw(n * pitch, -1);
+	CpuMatrixView<double, plas::MATRIX_ROWMAJOR> rows(&raw[0], n, pitch);
+	CpuMatrixView<double, plas::MATRIX_COLMAJOR> cols(&raw[0], n, pitch);
+	test::check(rows.size() == n && rows.pitch() == pitch && rows.raw() == &raw[0], "view accessors");
+
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			rows(i, j) = double(i * n + j);
+
+	bool same = true;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			same = same && raw[i * pitch + j] == double(i * n + j) && cols(j, i) == double(i * n + j);
+	test::check(same, "view addressing");
+
+	bool padding = true;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = n; j < pitch; ++j)
+			padding = padding && raw[i * pitch + j] == -1;
+	test::check(padding, "view wrote to the padding");
+}
+
+
+/* Operators give the same logical results on row-major and column-major states of the same 4-variable DBMs. */
+void orderings() {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	ukoct::EOperation operations[] = {
+		ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISINTCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISCLOSED, ukoct::OPER_ISSTRONGLYCLOSED,
+		ukoct::OPER_ISTIGHTLYCLOSED, ukoct::OPER_ISWEAKLYCLOSED, ukoct::OPER_ISTOP,
+		ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE, ukoct::OPER_SHORTESTPATH, ukoct::OPER_STRENGTHEN, ukoct::OPER_TIGHTEN, ukoct::OPER_TOP,
+		ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_PUSHOCTCONS, ukoct::OPER_FORGETOCTVAR, ukoct::OPER_INCCLOSURE,
+		ukoct::OPER_EQUALS, ukoct::OPER_INCLUDES, ukoct::OPER_UNION, ukoct::OPER_INTERSECTION, ukoct::OPER_WIDENING, ukoct::OPER_NARROWING
+	};
+
+	for (int round = 0; round < 50; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, 0.6, -1, 20, round % 2 == 0);
+		std::vector<double> o = test::randomDbm<double>(n, 0.6, -1, 20, round % 2 == 0);
+		if (round % 3 == 0) {
+			test::shortestPath(m, n);
+			test::strengthen(m, n);
+		}
+		plas::var_t var = rand() % (n / 2) + 1;
+		plas::OctDiffConstraint<double> diffCons(rand() % n + 1, rand() % n + 1, double(rand() % 10));
+		plas::OctConstraint<double> octCons(rand() % (n / 2) + 1, -plas::var_t(rand() % (n / 2) + 1), double(rand() % 10));
+		bool intBased = rand() % 2 == 0;
+
+		for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+			std::vector<double> results[2];
+			bool boolResults[2];
+			for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+				ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+				ukoct::CpuState<double>* other = test::newState(impl, o, rowMajor);
+				ukoct::OperatorArgs<double> args(*state);
+				args.other(other);
+				args.var(var);
+				args.diffCons(diffCons);
+				if (operations[k] != ukoct::OPER_INCCLOSURE || round % 4 == 0)
+					args.octCons(octCons);
+				args.intBased(intBased);
+				boolResults[rowMajor] = test::run(impl, operations[k], args);
+				results[rowMajor] = test::matrix(*state);
+				delete state;
+				delete other;
+			}
+			test::check(boolResults[0] == boolResults[1], "result depends on the ordering");
+			// Closures stopped by a negative cycle leave the matrix partial
+			bool closes = operations[k] == ukoct::OPER_CLOSURE || operations[k] == ukoct::OPER_TIGHTCLOSURE
+				|| operations[k] == ukoct::OPER_SHORTESTPATH || operations[k] == ukoct::OPER_INCCLOSURE;
+			if (!closes || boolResults[0])
+				test::check(results[0] == results[1], "state depends on the ordering");
+		}
+	}
+}
+
+
+int main(void) {
+	srand(11);
+	views();
+	orderings();
+	return test::result();
+}
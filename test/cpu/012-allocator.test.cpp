@@ -0,0 +1,150 @@
+#include <cstdint>
+#include <set>
+#include "common.hpp"
+
+using ukoct::impl::cpu::CpuAllocator;
+using ukoct::impl::cpu::CpuArenaAllocator;
+
+
+/* An arena which keeps track of the buffers it hands out. */
+class CountingAllocator : public CpuArenaAllocator {
+public:
+	CountingAllocator() :
+		allocations(0),
+		releases(0),
+		misaligned(0) {}
+
+
+	void* allocate(size_t bytes) {
+		void* ptr = CpuArenaAllocator::allocate(bytes);
+		++allocations;
+		if (reinterpret_cast<uintptr_t>(ptr) % ukoct_CPU_ALIGNMENT != 0)
+			++misaligned;
+		live.insert(ptr);
+		return ptr;
+	}
+
+
+	void release(void* ptr, size_t bytes) {
+		++releases;
+		live.erase(ptr);
+		CpuArenaAllocator::release(ptr, bytes);
+	}
+
+	size_t allocations;
+	size_t releases;
+	size_t misaligned;
+	std::set<void*> live;
+};
+
+
+/* Pitches keep rows aligned, and are no wider than needed. */
+void pitches() {
+	test::check(CpuAllocator::pitch<double>(8) == 8, "pitch of 8 doubles");
+	test::check(CpuAllocator::pitch<double>(10) == 16, "pitch of 10 doubles");
+	test::check(CpuAllocator::pitch<float>(8) == 16, "pitch of 8 floats");
+	test::check(CpuAllocator::pitch<int>(16) == 16, "pitch of 16 ints");
+	for (size_t n = 2; n <= 40; n += 2) {
+		size_t p = CpuAllocator::pitch<float>(n);
+		test::check(p >= n && p < n + 16 && p * sizeof(float) % ukoct_CPU_ALIGNMENT == 0, "aligned pitch");
+	}
+}
+
+
+/* Released buffers are handed out again, up to ukoct_CPU_ARENABYTES. */
+void arena() {
+	CpuArenaAllocator arena;
+	void* a = arena.allocate(1024);
+	void* b = arena.allocate(1024);
+	test::check(reinterpret_cast<uintptr_t>(a) % ukoct_CPU_ALIGNMENT == 0 && reinterpret_cast<uintptr_t>(b) % ukoct_CPU_ALIGNMENT == 0, "aligned buffers");
+	arena.release(a, 1024);
+	test::check(arena.cached() == 1024, "released buffer kept");
+	void* c = arena.allocate(512);
+	test::check(c != a, "buffer of another size reused");
+	arena.release(c, 512);
+	test::check(arena.allocate(1024) == a && arena.cached() == 512, "released buffer reused");
+
+	void* large = arena.allocate(ukoct_CPU_ARENABYTES);
+	arena.release(b, 1024);
+	arena.release(large, ukoct_CPU_ARENABYTES);
+	test::check(arena.cached() == 1536, "arena kept more than its maximum");
+	arena.clear();
+	test::check(arena.cached() == 0, "cleared arena");
+	arena.release(a, 1024);
+}
+
+
+/*
+ * States of 4-variable float DBMs, whose rows are padded, are allocated
+ * from the implementation's allocator, keep their padding at infinity, and
+ * give their buffers back when destroyed.
+ */
+void states(bool rowMajor) {
+	float inf = std::numeric_limits<float>::infinity();
+	size_t n = 8;
+	CountingAllocator allocator;
+	{
+		ukoct::CpuImplementation<float> impl(1, &allocator);
+		test::check(impl.allocator() == &allocator, "allocator not used");
+		ukoct::EOperation operations[] = {
+			ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE, ukoct::OPER_STRENGTHEN, ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_PUSHOCTCONS,
+			ukoct::OPER_FORGETOCTVAR, ukoct::OPER_INCCLOSURE, ukoct::OPER_UNION, ukoct::OPER_INTERSECTION, ukoct::OPER_WIDENING,
+			ukoct::OPER_COPY, ukoct::OPER_TOP
+		};
+
+		for (int round = 0; round < 20; ++round) {
+			std::vector<float> m = test::randomDbm<float>(n, 0.6, 0, 20, true);
+			ukoct::CpuState<float>* state = test::newState(impl, m, rowMajor);
+			ukoct::CpuState<float>* other = test::newState(impl, test::randomDbm<float>(n, 0.6, 0, 20, true), rowMajor);
+			test::check(state->pitch() == 16, "padded pitch");
+			test::check(reinterpret_cast<uintptr_t>(state->input().raw()) % ukoct_CPU_ALIGNMENT == 0, "aligned matrix");
+			test::check(test::matrix(*state) == m, "padded setup");
+
+			std::vector<float> expected(m);
+			test::shortestPath(expected, n);
+			test::strengthen(expected, n);
+			ukoct::CpuState<float>* closed = state->clone();
+			test::run(impl, ukoct::OPER_CLOSURE, *closed);
+			test::check(test::matrix(*closed) == expected, "closure of a padded matrix");
+			delete closed;
+
+			for (size_t k = 0; k < sizeof(operations) / sizeof(operations[0]); ++k) {
+				ukoct::OperatorArgs<float> args(*state);
+				args.other(other);
+				args.var(rand() % (n / 2) + 1);
+				args.diffCons(plas::OctDiffConstraint<float>(rand() % n + 1, rand() % n + 1, float(rand() % 10)));
+				args.octCons(plas::OctConstraint<float>(rand() % (n / 2) + 1, -plas::var_t(rand() % (n / 2) + 1), float(rand() % 10)));
+				test::run(impl, operations[k], args);
+			}
+
+			bool padding = true;
+			const float* raw = state->input().raw();
+			for (size_t i = 0; i < n; ++i)
+				for (size_t j = n; j < state->pitch(); ++j)
+					padding = padding && raw[i * state->pitch() + j] == inf;
+			test::check(padding, "padding overwritten");
+			delete state;
+			delete other;
+		}
+
+		test::check(allocator.live.empty(), "buffers not given back");
+		test::check(allocator.misaligned == 0, "misaligned buffers");
+		test::check(allocator.cached() > 0, "buffers not kept for reuse");
+		// Buffers of states of the same size are recycled
+		size_t cached = allocator.cached();
+		ukoct::CpuState<float>* state = test::newState(impl, test::randomDbm<float>(n, 0.6, 0, 20, true), rowMajor);
+		test::check(allocator.cached() < cached, "buffer not recycled");
+		delete state;
+	}
+	test::check(allocator.allocations == allocator.releases, "allocations and releases");
+}
+
+
+int main(void) {
+	srand(12);
+	pitches();
+	arena();
+	states(true);
+	states(false);
+	return test::result();
+}
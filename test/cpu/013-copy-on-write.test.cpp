@@ -0,0 +1,96 @@
+#include "common.hpp"
+
+
+/* Clones share the matrix until one of them is mutated, which leaves the others as they were. */
+void clones(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	ukoct::EOperation mutators[] = {
+		ukoct::OPER_CLOSURE, ukoct::OPER_TIGHTCLOSURE, ukoct::OPER_SHORTESTPATH, ukoct::OPER_STRENGTHEN, ukoct::OPER_TIGHTEN,
+		ukoct::OPER_TOP, ukoct::OPER_PUSHDIFFCONS, ukoct::OPER_PUSHOCTCONS, ukoct::OPER_FORGETOCTVAR, ukoct::OPER_INCCLOSURE,
+		ukoct::OPER_UNION, ukoct::OPER_INTERSECTION, ukoct::OPER_WIDENING, ukoct::OPER_NARROWING,
+		// Checks which zero the diagonal
+		ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISCLOSED, ukoct::OPER_ISSTRONGLYCLOSED, ukoct::OPER_ISTIGHTLYCLOSED
+	};
+	ukoct::EOperation readers[] = {
+		ukoct::OPER_ISINTCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISTOP, ukoct::OPER_EQUALS, ukoct::OPER_INCLUDES
+	};
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<double> m = test::randomDbm<double>(n, 0.6, 0, 20, true);
+		m[rand() % n * (n + 1)] = 1;
+		ukoct::CpuState<double>* other = test::newState(impl, test::randomDbm<double>(n, 0.6, 0, 20, true), rowMajor);
+
+		for (size_t k = 0; k < sizeof(mutators) / sizeof(mutators[0]); ++k) {
+			ukoct::CpuState<double>* original = test::newState(impl, m, rowMajor);
+			ukoct::CpuState<double>* clone = original->clone();
+			ukoct::CpuState<double>* third = clone->clone();
+			test::check(original->shared() && clone->input().raw() == original->input().raw(), "clone not shared");
+
+			for (size_t r = 0; r < sizeof(readers) / sizeof(readers[0]); ++r)
+				test::run(impl, readers[r], *clone, other);
+			test::check(clone->input().raw() == original->input().raw(), "clone detached by a reader");
+
+			ukoct::OperatorArgs<double> args(*clone);
+			args.other(other);
+			args.var(rand() % (n / 2) + 1);
+			args.diffCons(plas::OctDiffConstraint<double>(rand() % n + 1, rand() % n + 1, double(rand() % 10 - 30)));
+			args.octCons(plas::OctConstraint<double>(rand() % (n / 2) + 1, -plas::var_t(rand() % (n / 2) + 1), double(rand() % 10 - 30)));
+			test::run(impl, mutators[k], args);
+
+			test::check(clone->input().raw() != original->input().raw(), "clone not detached by a mutator");
+			test::check(third->input().raw() == original->input().raw() && original->shared(), "other clones detached");
+			test::check(test::matrix(*original) == m && test::matrix(*third) == m, "original mutated through a clone");
+			test::check(clone->rowMajor() == rowMajor && clone->diffSize() == n, "detached clone layout");
+
+			// The last reference keeps the buffer alive
+			delete original;
+			test::check(!third->shared() && test::matrix(*third) == m, "buffer released while shared");
+			delete third;
+			delete clone;
+		}
+		delete other;
+	}
+}
+
+
+/* The copy operator shares the source matrix, its ordering and flags. */
+void copies(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	std::vector<double> m = test::randomDbm<double>(n, 0.6, 0, 20, true);
+	ukoct::CpuState<double>* source = test::newState(impl, m, rowMajor);
+	ukoct::CpuState<double>* dest = test::newState(impl, test::randomDbm<double>(n, 0.6, 0, 20, true), !rowMajor);
+	test::run(impl, ukoct::OPER_CLOSURE, *source);
+	std::vector<double> closed = test::matrix(*source);
+
+	test::run(impl, ukoct::OPER_COPY, *dest, source);
+	test::check(dest->input().raw() == source->input().raw() && dest->rowMajor() == rowMajor, "copy not shared");
+	test::check(dest->flags().holds(ukoct::impl::cpu::CPUSTATE_CLOSED), "copy flags");
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *dest, source), "copy not equal");
+
+	test::run(impl, ukoct::OPER_PUSHDIFFCONS, ukoct::OperatorArgs<double>(*dest).diffCons(plas::OctDiffConstraint<double>(1, 3, -50)));
+	test::check(dest->input().raw() != source->input().raw(), "copy not detached");
+	test::check(test::matrix(*source) == closed, "source mutated through a copy");
+	test::check(source->flags().holds(ukoct::impl::cpu::CPUSTATE_CLOSED), "source flags forgotten through a copy");
+	test::check(!test::run(impl, ukoct::OPER_EQUALS, *dest, source), "mutated copy equal");
+
+	// Copying a state onto itself, or onto one sharing its matrix, is harmless
+	test::run(impl, ukoct::OPER_COPY, *source, source);
+	ukoct::CpuState<double>* clone = source->clone();
+	test::run(impl, ukoct::OPER_COPY, *clone, source);
+	test::check(test::matrix(*source) == closed && test::matrix(*clone) == closed, "copy of a shared matrix");
+	delete clone;
+	delete dest;
+	delete source;
+}
+
+
+int main(void) {
+	srand(13);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		clones(rowMajor);
+		copies(rowMajor);
+	}
+	return test::result();
+}
@@ -0,0 +1,130 @@
+#include <cstdio>
+#include <fstream>
+#include "common.hpp"
+
+using namespace ukoct::impl::cpu;
+
+
+/* Whether mapping the file throws an Error, leaving the state as it was. */
+template <typename T> bool rejected(ukoct::CpuImplementation<T>& impl, const char* path) {
+	ukoct::CpuState<T>* state = impl.newState();
+	bool thrown = false;
+	try {
+		state->map(path);
+	} catch (const ukoct::Error&) {
+		thrown = true;
+	}
+	thrown = thrown && !state->isValid();
+	delete state;
+	return thrown;
+}
+
+
+/* Saved 4-variable states are mapped back with the same matrix, ordering and flags. */
+template <typename T> void roundTrip(bool rowMajor) {
+	const char* path = "014-snapshot.dbm";
+	ukoct::CpuImplementation<T> impl;
+	size_t n = 8;
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<T> m = test::randomDbm<T>(n, 0.6, round % 3 == 0 ? -3 : 0, 20, true);
+		ukoct::CpuState<T>* state = test::newState(impl, m, rowMajor);
+		test::run(impl, round % 2 == 0 ? ukoct::OPER_CLOSURE : ukoct::OPER_ISCOHERENT, *state);
+		state->save(path);
+
+		ukoct::CpuState<T>* mapped = impl.newState();
+		mapped->map(path);
+		test::check(mapped->isValid() && mapped->diffSize() == n && mapped->rowMajor() == rowMajor, "mapped layout");
+		test::check(mapped->pitch() == state->pitch(), "mapped pitch");
+		test::check(reinterpret_cast<uintptr_t>(mapped->input().raw()) % ukoct_CPU_ALIGNMENT == 0, "mapped alignment");
+		test::check(test::matrix(*mapped) == test::matrix(*state), "mapped matrix");
+		test::check(mapped->flags().knownMask() == state->flags().knownMask() && mapped->flags().valueMask() == state->flags().valueMask(), "mapped flags");
+		test::check(test::run(impl, ukoct::OPER_EQUALS, *mapped, state), "mapped state not equal");
+
+		// Mutating a mapped state, or a copy of it, leaves the file untouched
+		ukoct::CpuState<T>* clone = mapped->clone();
+		delete mapped;
+		std::vector<T> saved = test::matrix(*clone);
+		test::run(impl, ukoct::OPER_PUSHDIFFCONS, ukoct::OperatorArgs<T>(*clone).diffCons(plas::OctDiffConstraint<T>(1, 4, -40)));
+		test::run(impl, ukoct::OPER_TOP, *clone);
+		delete clone;
+
+		mapped = impl.newState();
+		mapped->map(path);
+		test::check(test::matrix(*mapped) == saved, "snapshot written through a mapping");
+		test::run(impl, ukoct::OPER_CLOSURE, *state);
+		test::run(impl, ukoct::OPER_CLOSURE, *mapped);
+		test::check(test::matrix(*mapped) == test::matrix(*state), "closure of a mapped state");
+		delete mapped;
+		delete state;
+	}
+	std::remove(path);
+}
+
+
+/* Files which aren't snapshots of matrices of the right type are rejected. */
+void invalid() {
+	const char* path = "014-invalid.dbm";
+	ukoct::CpuImplementation<double> impl;
+	ukoct::CpuImplementation<float> floatImpl;
+	ukoct::CpuState<double>* state = test::newState(impl, test::randomDbm<double>(8, 0.6, 0, 20, true));
+	state->save(path);
+	test::check(rejected(floatImpl, path), "snapshot of another type");
+
+	// Mapping into a set up state is an error as well
+	bool thrown = false;
+	try {
+		state->map(path);
+	} catch (const ukoct::Error&) {
+		thrown = true;
+	}
+	test::check(thrown && state->diffSize() == 8, "mapped into a set up state");
+	delete state;
+
+	std::vector<char> bytes;
+	{
+		std::ifstream is(path, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+	}
+
+	for (int corruption = 0; corruption < 7; ++corruption) {
+		std::vector<char> corrupt(bytes);
+		CpuSnapshotHeader& header = *reinterpret_cast<CpuSnapshotHeader*>(&corrupt[0]);
+		if (corruption == 0)
+			header.magic[0] = 'X';
+		else if (corruption == 1)
+			header.version = CpuSnapshotHeader::currentVersion + 1;
+		else if (corruption == 2)
+			header.diffSize = 7;
+		else if (corruption == 3)
+			header.offset += 1;
+		else if (corruption == 4)
+			corrupt.resize(corrupt.size() - sizeof(double));
+		else {
+			// Sizes whose matrix size wraps around, or whose pitch in bytes does
+			header.diffSize = corruption == 5 ? uint64_t(1) << 32 : uint64_t(1) << 61;
+			header.pitch = CpuAllocator::pitch<double>(header.diffSize);
+		}
+
+		std::ofstream os(path, std::ios::binary | std::ios::trunc);
+		os.write(&corrupt[0], corrupt.size());
+		os.close();
+		test::check(rejected(impl, path), "corrupt snapshot");
+	}
+
+	std::ofstream(path, std::ios::trunc).close();
+	test::check(rejected(impl, path), "empty snapshot");
+	std::remove(path);
+	test::check(rejected(impl, path), "missing snapshot");
+}
+
+
+int main(void) {
+	srand(14);
+	for (int rowMajor = 0; rowMajor < 2; ++rowMajor) {
+		roundTrip<double>(rowMajor);
+		roundTrip<float>(rowMajor);
+	}
+	invalid();
+	return test::result();
+}
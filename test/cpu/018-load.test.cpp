@@ -0,0 +1,92 @@
+#include <sstream>
+#include "common.hpp"
+
+
+/* Whether loading the problem throws an Error, leaving the state unset. */
+bool rejected(ukoct::CpuImplementation<double>& impl, const std::string& source) {
+	std::istringstream is(source);
+	plas::Problem<double> problem;
+	ukoct::CpuState<double>* state = impl.newState();
+	bool thrown = false;
+	try {
+		state->load(is, problem);
+	} catch (const ukoct::Error&) {
+		thrown = true;
+	}
+	thrown = thrown && !state->isValid();
+	delete state;
+	return thrown;
+}
+
+
+/* 4-variable problems are loaded with the tightest constant of each cell, and closed as set up ones. */
+void load() {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+
+	for (int round = 0; round < 30; ++round) {
+		std::ostringstream os;
+		os << "p oct 4\n";
+		for (int i = rand() % 40; i >= 0; --i) {
+			os << "e " << rand() % 4 + 1;
+			if (i % 4 != 0)
+				os << (rand() % 2 ? " -" : " ") << rand() % 4 + 1;
+			os << " " << rand() % 30 - 5 << "\n";
+		}
+		std::string source = os.str();
+
+		std::istringstream is(source);
+		plas::Problem<double> problem;
+		plas::open(is, problem);
+		plas::Problem<double> diff;
+		plas::toOctDiffProblem(problem, diff);
+		std::vector<double> expected(n * n, std::numeric_limits<double>::infinity());
+		for (size_t i = 0; i < diff.entries().size(); ++i) {
+			plas::OctDiffConstraint<double>& cons = diff.entry(i).octConstraint();
+			double& cell = expected[(cons.a() - 1) * n + cons.b() - 1];
+			cell = std::min(cell, cons.constant());
+		}
+
+		std::istringstream streamed(source);
+		plas::Problem<double> header;
+		ukoct::CpuState<double>* state = impl.newState();
+		state->load(streamed, header, round % 2 == 0);
+		test::check(state->isValid() && state->diffSize() == n && state->rowMajor(), "loaded layout");
+		test::check(test::matrix(*state) == expected, "loaded matrix");
+		test::check(header.entries().size() == (round % 2 == 0 ? problem.entries().size() : 0), "loaded entries");
+		test::check(state->flags().knownMask() == 0, "loaded flags");
+
+		for (size_t i = 0; i < n; ++i)
+			expected[i * n + i] = std::min(expected[i * n + i], 0.0);
+		ukoct::CpuState<double>* setup = test::newState(impl, expected);
+		bool consistent = test::run(impl, ukoct::OPER_CLOSURE, *setup);
+		test::check(test::run(impl, ukoct::OPER_CLOSURE, *state) == consistent, "loaded consistency");
+		if (consistent)
+			test::check(test::matrix(*state) == test::matrix(*setup), "loaded closure");
+		delete setup;
+		delete state;
+	}
+
+	test::check(rejected(impl, "p oct\ne 1 2 3\n"), "problem of undeclared size");
+	test::check(rejected(impl, "e 1 2 3\n"), "missing problem line");
+	test::check(rejected(impl, "p octdiff 3\ne 1 2 3\n"), "odd octdiff size");
+
+	ukoct::CpuState<double>* state = test::newState(impl, test::randomDbm<double>(n, 0.5, 0, 20, true));
+	std::istringstream again("p oct 4\n");
+	plas::Problem<double> problem;
+	bool thrown = false;
+	try {
+		state->load(again, problem);
+	} catch (const ukoct::Error&) {
+		thrown = true;
+	}
+	test::check(thrown && state->diffSize() == n, "loaded into a set up state");
+	delete state;
+}
+
+
+int main(void) {
+	srand(18);
+	load();
+	return test::result();
+}
@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include "common.hpp"
+
+typedef long long Ref;
+static const Ref refInf = std::numeric_limits<Ref>::max();
+
+
+/*
+ * Integer closure of Bagnara et al.: shortest paths, tightening, then
+ * strengthening. Returns whether the matrix is consistent over the rationals,
+ * as the closure operator does, integer consistency being checked apart.
+ */
+bool refClosure(std::vector<Ref>& m, size_t n) {
+	for (size_t k = 0; k < n; ++k)
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				if (m[i * n + k] != refInf && m[k * n + j] != refInf)
+					m[i * n + j] = std::min(m[i * n + j], m[i * n + k] + m[k * n + j]);
+
+	for (size_t i = 0; i < n; ++i)
+		if (m[i * n + i] < 0)
+			return false;
+
+	for (size_t i = 0; i < n; ++i) {
+		Ref& iI = m[i * n + (i ^ 1)];
+		if (iI != refInf && iI % 2 != 0)
+			iI -= 1;
+	}
+
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t j = 0; j < n; ++j) {
+			Ref iI = m[i * n + (i ^ 1)];
+			Ref Jj = m[(j ^ 1) * n + j];
+			if (iI != refInf && Jj != refInf)
+				m[i * n + j] = std::min(m[i * n + j], (iI + Jj) / 2);
+		}
+	}
+	return true;
+}
+
+
+/* Closes m as an integer DBM of T and compares with the reference closure. */
+template <typename T> void closure(const std::vector<Ref>& m, size_t n, bool rowMajor) {
+	ukoct::CpuImplementation<T> impl;
+	T inf = impl.infinity();
+	std::vector<T> input(n * n);
+	for (size_t i = 0; i < n * n; ++i)
+		input[i] = m[i] == refInf ? inf : T(m[i]);
+
+	std::vector<Ref> expected(m);
+	bool consistent = refClosure(expected, n);
+
+	ukoct::CpuState<T>* state = test::newState(impl, input, rowMajor);
+	ukoct::OperatorArgs<T> args(*state);
+	args.intBased(true);
+	bool result = test::run(impl, ukoct::OPER_CLOSURE, args);
+	test::check(result == consistent, "integer consistency");
+
+	if (result && consistent) {
+		std::vector<T> closed = test::matrix(*state);
+		bool same = true;
+		for (size_t i = 0; i < n * n; ++i)
+			same = same && (closed[i] == inf ? expected[i] == refInf : expected[i] == Ref(closed[i]));
+		test::check(same, "integer closure");
+	}
+
+	delete state;
+
+	// Inputs are coherent, so the half-matrix implementation agrees
+	ukoct::CpuHalfImplementation<T> halfImpl;
+	ukoct::IState<T>* half = halfImpl.newState();
+	half->setup(n, &input[0], true);
+	ukoct::OperatorArgs<T> halfArgs(*half);
+	halfArgs.intBased(true);
+	ukoct::IOperator<T>* op = halfImpl.newOperator(ukoct::OPER_CLOSURE);
+	op->run(halfArgs);
+	test::check(op->boolResult() == consistent, "half-matrix integer consistency");
+
+	if (op->boolResult() && consistent) {
+		std::vector<T> closed(n * n);
+		half->copyTo(&closed[0]);
+		bool same = true;
+		for (size_t i = 0; i < n * n; ++i)
+			same = same && (closed[i] == inf ? expected[i] == refInf : expected[i] == Ref(closed[i]));
+		test::check(same, "half-matrix integer closure");
+	}
+
+	delete op;
+	delete half;
+}
+
+
+template <typename T> void saturation() {
+	typedef ukoct::ElemTypeInfo<T> Info;
+	T inf = Info::infinity();
+	test::check(Info::add(inf, -5) == inf && Info::add(-5, inf) == inf, "infinity absorbs sums");
+	test::check(Info::add(inf - 1, 10) == inf, "sums saturate to infinity");
+	test::check(Info::add(std::numeric_limits<T>::min() + 1, -10) == std::numeric_limits<T>::min(), "sums saturate to the minimum");
+	test::check(Info::floorHalf(-3) == -2 && Info::floorHalf(3) == 1 && Info::floorHalf(inf) == inf, "floorHalf");
+	test::check(Info::floorEven(-3) == -4 && Info::floorEven(3) == 2 && Info::floorEven(inf) == inf, "floorEven");
+}
+
+
+int main(void) {
+	saturation<int32_t>();
+	saturation<int64_t>();
+
+	// x0 - x1 <= 0.5, as the single bound m[0][2] = 1, which closure must keep
+	std::vector<Ref> simple(16, refInf);
+	for (size_t i = 0; i < 4; ++i)
+		simple[i * 4 + i] = 0;
+	simple[0 * 4 + 2] = 1;
+	simple[3 * 4 + 1] = 1;
+	closure<int32_t>(simple, 4, true);
+	closure<int64_t>(simple, 4, false);
+	closure<double>(simple, 4, true);
+
+	// Random coherent DBMs over four variables
+	srand(20);
+	size_t n = 8;
+	for (int t = 0; t < 200; ++t) {
+		std::vector<Ref> m(n * n, refInf);
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t j = 0; j < n; ++j) {
+				if (i == j)
+					m[i * n + j] = 0;
+				else if (rand() % 3 == 0)
+					m[i * n + j] = m[(j ^ 1) * n + (i ^ 1)] = rand() % 21 - 4;
+			}
+		}
+		closure<int32_t>(m, n, t % 2 == 0);
+		closure<int64_t>(m, n, t % 2 == 1);
+		closure<double>(m, n, t % 3 == 0);
+	}
+
+	return test::result();
+}
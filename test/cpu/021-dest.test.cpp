@@ -0,0 +1,92 @@
+#include "common.hpp"
+
+using namespace ukoct::impl::cpu;
+
+
+/* Whether the flags known for a state hold for its matrix, as checked from scratch by the predicates. */
+bool truthful(ukoct::CpuImplementation<double>& impl, ukoct::CpuState<double>& state) {
+	static const unsigned int flags[] = { CPUSTATE_CONSISTENT, CPUSTATE_COHERENT, CPUSTATE_CLOSED, CPUSTATE_STRONGLYCLOSED, CPUSTATE_TIGHTLYCLOSED };
+	static const ukoct::EOperation predicates[] = { ukoct::OPER_ISCONSISTENT, ukoct::OPER_ISCOHERENT, ukoct::OPER_ISCLOSED, ukoct::OPER_ISSTRONGLYCLOSED, ukoct::OPER_ISTIGHTLYCLOSED };
+	std::vector<double> m = test::matrix(state);
+	bool ok = true;
+
+	for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f) {
+		if (!state.flags().known(flags[f]))
+			continue;
+		ukoct::CpuState<double>* fresh = test::newState(impl, m);
+		ok = ok && state.flags().holds(flags[f]) == test::run(impl, predicates[f], *fresh);
+		delete fresh;
+	}
+	return ok;
+}
+
+
+/*
+ * Unions and intersections of closed 4-variable DBMs, written to a fresh
+ * state, to either operand or in place, leave the operands which aren't
+ * written untouched, and keep the closure of unions.
+ */
+void destinations(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+
+	for (int round = 0; round < 40; ++round) {
+		ukoct::CpuState<double>* a = test::newState(impl, test::randomDbm<double>(n, 0.5, -2, 20, true), rowMajor);
+		ukoct::CpuState<double>* b = test::newState(impl, test::randomDbm<double>(n, 0.5, -2, 20, true), round % 2 == 0 ? rowMajor : !rowMajor);
+		bool consistent = test::run(impl, ukoct::OPER_CLOSURE, *a) && test::run(impl, ukoct::OPER_CLOSURE, *b);
+		std::vector<double> ma = test::matrix(*a);
+		std::vector<double> mb = test::matrix(*b);
+
+		for (int join = 0; join < 2; ++join) {
+			std::vector<double> expected(n * n);
+			for (size_t i = 0; i < n * n; ++i)
+				expected[i] = join ? std::max(ma[i], mb[i]) : std::min(ma[i], mb[i]);
+
+			for (int dest = 0; dest < 4; ++dest) {
+				// Clones share the operands' buffers, so that writing them must detach them
+				ukoct::CpuState<double>* sa = a->clone();
+				ukoct::CpuState<double>* sb = b->clone();
+				ukoct::CpuState<double>* sd = impl.newState();
+				ukoct::CpuState<double>* target = dest == 0 ? sd : dest == 1 ? sb : sa;
+				ukoct::OperatorArgs<double> args(*sa);
+				args.other(sb);
+				args.dest(dest == 3 ? NULL : target);
+				test::run(impl, join ? ukoct::OPER_UNION : ukoct::OPER_INTERSECTION, args);
+
+				test::check(test::matrix(*target) == expected, join ? "union" : "intersection");
+				test::check(test::matrix(*a) == ma && test::matrix(*b) == mb, "operands mutated through their clones");
+				test::check(target == sa || (test::matrix(*sa) == ma && sa->input().raw() == a->input().raw()), "first operand written");
+				test::check(target == sb || (test::matrix(*sb) == mb && sb->input().raw() == b->input().raw()), "second operand written");
+				test::check(target == sd || !sd->isValid(), "unused destination set up");
+				test::check(target->diffSize() == n && target->rowMajor() == (target == sb ? b->rowMajor() : rowMajor), "destination layout");
+				test::check(truthful(impl, *target), "destination flags don't hold");
+				if (consistent && join)
+					test::check(target->flags().holds(CPUSTATE_CLOSED | CPUSTATE_STRONGLYCLOSED), "union of closed DBMs not known closed");
+				if (target->partition(false).valid())
+					test::check(target->partition(false).size() == n / 2, "destination partition");
+				delete sa;
+				delete sb;
+				delete sd;
+			}
+		}
+
+		// The union or intersection of a DBM with itself is itself
+		ukoct::CpuState<double>* self = impl.newState();
+		ukoct::OperatorArgs<double> args(*a);
+		args.other(a);
+		args.dest(self);
+		test::run(impl, round % 2 ? ukoct::OPER_UNION : ukoct::OPER_INTERSECTION, args);
+		test::check(test::matrix(*self) == ma && test::matrix(*a) == ma, "operation with itself");
+		delete self;
+		delete a;
+		delete b;
+	}
+}
+
+
+int main(void) {
+	srand(21);
+	destinations(true);
+	destinations(false);
+	return test::result();
+}
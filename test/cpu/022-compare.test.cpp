@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstdlib>
+#include "common.hpp"
+
+
+/* Equals and Includes give the same answers for every mix of orderings, on 4-variable DBMs. */
+void orderings() {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+
+	for (int round = 0; round < 50; ++round) {
+		std::vector<double> a(n * n), b(n * n);
+		for (size_t i = 0; i < n * n; ++i) {
+			a[i] = double(rand() % 9);
+			b[i] = rand() % 3 == 0 ? double(rand() % 9) : a[i];
+		}
+		bool equal = a == b;
+		bool includes = true;
+		for (size_t i = 0; i < n * n; ++i)
+			includes = includes && b[i] <= a[i];
+
+		for (int rowMajorA = 0; rowMajorA < 2; ++rowMajorA) {
+			for (int rowMajorB = 0; rowMajorB < 2; ++rowMajorB) {
+				ukoct::CpuState<double>* sa = test::newState(impl, a, rowMajorA);
+				ukoct::CpuState<double>* sb = test::newState(impl, b, rowMajorB);
+				test::check(test::run(impl, ukoct::OPER_EQUALS, *sa, sb) == equal, "equals of mixed orderings");
+				test::check(test::run(impl, ukoct::OPER_INCLUDES, *sa, sb) == includes, "includes of mixed orderings");
+				delete sa;
+				delete sb;
+			}
+		}
+	}
+}
+
+
+/* Comparing uses the known fingerprints without computing any, and they're forgotten once a state is mutated. */
+void fingerprints() {
+	ukoct::CpuImplementation<double> impl;
+	size_t n = 8;
+	std::vector<double> a(n * n), b(n * n);
+	for (size_t i = 0; i < n * n; ++i) {
+		a[i] = double(i % 5);
+		b[i] = std::min(a[i], double(i % 3));
+	}
+
+	ukoct::CpuState<double>* sa = test::newState(impl, a);
+	ukoct::CpuState<double>* sb = test::newState(impl, a);
+	test::check(!sa->fingerprinted() && !sb->fingerprinted(), "fingerprint computed before use");
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sa, sb), "equal matrices");
+	test::check(!sa->fingerprinted() && !sb->fingerprinted(), "fingerprints computed by equals");
+	sa->fingerprint();
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sb, sa), "equal matrices with a known fingerprint");
+	test::check(sb->fingerprinted() && sa->fingerprint() == sb->fingerprint(), "known fingerprint not passed on");
+
+	// Differing fingerprints, once known, tell matrices apart
+	ukoct::CpuState<double>* unequal = test::newState(impl, b);
+	unequal->fingerprint();
+	test::check(!test::run(impl, ukoct::OPER_EQUALS, *sa, unequal), "matrices with differing fingerprints");
+	delete unequal;
+
+	// Intersecting into a copy detaches it from the shared buffer
+	ukoct::CpuState<double>* sc = sa->clone();
+	ukoct::CpuState<double>* other = test::newState(impl, b);
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sa, sc), "copy");
+	ukoct::OperatorArgs<double> args(*sc);
+	args.other(other);
+	test::run(impl, ukoct::OPER_INTERSECTION, args);
+	test::check(!sc->fingerprinted(), "fingerprint kept after mutation");
+	test::check(!test::run(impl, ukoct::OPER_EQUALS, *sa, sc), "mutated copy");
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sa, sb), "original after its copy was mutated");
+
+	// Mutating it back gives the same matrix, and fingerprint, again
+	ukoct::CpuState<double>* sd = test::newState(impl, b);
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sc, sd), "intersection");
+	ukoct::OperatorArgs<double> back(*sc);
+	back.other(sa);
+	test::run(impl, ukoct::OPER_UNION, back);
+	test::check(test::run(impl, ukoct::OPER_EQUALS, *sa, sc), "matrix mutated back");
+	test::check(sa->fingerprint() == sc->fingerprint(), "fingerprint of the matrix mutated back");
+
+	delete sa;
+	delete sb;
+	delete sc;
+	delete sd;
+	delete other;
+}
+
+
+int main(void) {
+	srand(22);
+	orderings();
+	fingerprints();
+	return test::result();
+}
@@ -0,0 +1,79 @@
+#include <cstdlib>
+#include <limits>
+#include "common.hpp"
+
+
+/* Reference widening of a by b, with ascending thresholds tried before infinity. */
+std::vector<double> widen(const std::vector<double>& a, const std::vector<double>& b, const std::vector<double>& thresholds) {
+	std::vector<double> m(a.size());
+	for (size_t i = 0; i < a.size(); ++i) {
+		m[i] = std::numeric_limits<double>::infinity();
+		if (b[i] <= a[i])
+			m[i] = a[i];
+		else
+			for (size_t t = thresholds.size(); t-- > 0; )
+				if (thresholds[t] >= b[i])
+					m[i] = thresholds[t];
+	}
+	return m;
+}
+
+
+/* Reference narrowing of a by b. */
+std::vector<double> narrow(const std::vector<double>& a, const std::vector<double>& b) {
+	std::vector<double> m(a.size());
+	for (size_t i = 0; i < a.size(); ++i)
+		m[i] = a[i] == std::numeric_limits<double>::infinity() ? b[i] : a[i];
+	return m;
+}
+
+
+/* Widening and narrowing of 4-variable DBMs combine the same cells whatever their orderings and destination. */
+void orderings() {
+	ukoct::CpuImplementation<double> impl;
+	double inf = std::numeric_limits<double>::infinity();
+	size_t n = 8;
+	std::vector<double> thresholds;
+	thresholds.push_back(2);
+	thresholds.push_back(5);
+
+	for (int round = 0; round < 10; ++round) {
+		std::vector<double> a(n * n), b(n * n);
+		for (size_t i = 0; i < n * n; ++i) {
+			a[i] = rand() % 4 == 0 ? inf : double(rand() % 9 - 2);
+			b[i] = rand() % 4 == 0 ? inf : double(rand() % 9 - 2);
+		}
+
+		for (int rowMajorA = 0; rowMajorA < 2; ++rowMajorA) {
+			for (int rowMajorB = 0; rowMajorB < 2; ++rowMajorB) {
+				for (int dest = 0; dest < 3; ++dest) {
+					for (int operation = 0; operation < 3; ++operation) {
+						ukoct::CpuState<double>* sa = test::newState(impl, a, rowMajorA);
+						ukoct::CpuState<double>* sb = test::newState(impl, b, rowMajorB);
+						ukoct::CpuState<double>* sd = impl.newState();
+						ukoct::IState<double>* target = dest == 0 ? sa : dest == 1 ? sb : sd;
+						ukoct::OperatorArgs<double> args(*sa);
+						args.other(sb);
+						args.dest(target);
+						if (operation == 1)
+							args.thresholds(&thresholds);
+						test::run(impl, operation == 2 ? ukoct::OPER_NARROWING : ukoct::OPER_WIDENING, args);
+
+						std::vector<double> expected = operation == 2 ? narrow(a, b) : widen(a, b, operation == 1 ? thresholds : std::vector<double>());
+						test::check(test::matrix(*target) == expected, operation == 2 ? "narrowing of mixed orderings" : "widening of mixed orderings");
+						delete sa;
+						delete sb;
+						delete sd;
+					}
+				}
+			}
+		}
+	}
+}
+
+
+int main(void) {
+	srand(23);
+	orderings();
+	return test::result();
+}
@@ -0,0 +1,119 @@
+#include "ukoct/core.hpp"
+#include "common.hpp"
+
+
+/*
+ * Unions and intersections of many n x n DBMs of mixed orderings, repeated
+ * operands among them, written in place, to a fresh state or to one of the
+ * operands, are the elementwise maximum or minimum of them all.
+ */
+void nary(ukoct::CpuImplementation<double>& impl, size_t n, int rounds) {
+	for (int round = 0; round < rounds; ++round) {
+		size_t k = rand() % 5 + 2;
+		std::vector<ukoct::CpuState<double>*> states(k);
+		std::vector<std::vector<double> > ms(k);
+		bool consistent = true;
+		for (size_t s = 0; s < k; ++s) {
+			states[s] = test::newState(impl, test::randomDbm<double>(n, 0.5, -2, 20, true), rand() % 2 == 0);
+			consistent = test::run(impl, ukoct::OPER_CLOSURE, *states[s]) && consistent;
+			ms[s] = test::matrix(*states[s]);
+		}
+
+		for (int join = 0; join < 2; ++join) {
+			std::vector<double> expected(ms[0]);
+			for (size_t s = 1; s < k; ++s)
+				for (size_t i = 0; i < n * n; ++i)
+					expected[i] = join ? std::max(expected[i], ms[s][i]) : std::min(expected[i], ms[s][i]);
+
+			for (int dest = 0; dest < 3; ++dest) {
+				std::vector<ukoct::CpuState<double>*> clones(k);
+				for (size_t s = 0; s < k; ++s)
+					clones[s] = states[s]->clone();
+				// Operands may be given more than once, and either through other() or others()
+				std::vector<ukoct::IState<double>*> others(clones.begin() + 1, clones.end());
+				others.push_back(clones[rand() % k]);
+				ukoct::CpuState<double>* fresh = impl.newState();
+				ukoct::CpuState<double>* target = dest == 0 ? clones[0] : dest == 1 ? fresh : clones[rand() % (k - 1) + 1];
+
+				ukoct::OperatorArgs<double> args(*clones[0]);
+				if (round % 2 == 0) {
+					args.other(others[0]);
+					args.others(&others[1], others.size() - 1);
+				} else {
+					args.others(&others[0], others.size());
+				}
+				args.dest(dest == 0 ? NULL : target);
+				test::run(impl, join ? ukoct::OPER_UNION : ukoct::OPER_INTERSECTION, args);
+
+				test::check(test::matrix(*target) == expected, join ? "n-ary union" : "n-ary intersection");
+				bool untouched = true;
+				for (size_t s = 0; s < k; ++s) {
+					untouched = untouched && test::matrix(*states[s]) == ms[s];
+					if (clones[s] != target)
+						untouched = untouched && test::matrix(*clones[s]) == ms[s] && clones[s]->input().raw() == states[s]->input().raw();
+				}
+				test::check(untouched, "n-ary operands written");
+				if (consistent && join)
+					test::check(target->flags().holds(ukoct::impl::cpu::CPUSTATE_CLOSED), "n-ary union of closed DBMs not known closed");
+				for (size_t s = 0; s < k; ++s)
+					delete clones[s];
+				delete fresh;
+			}
+		}
+		for (size_t s = 0; s < k; ++s)
+			delete states[s];
+	}
+}
+
+
+/* OctDbm joins and intersects with many 4-variable DBMs at once, as it would one at a time. */
+void dbms(ukoct::CpuImplementation<double>& impl) {
+	size_t n = 8;
+	for (int round = 0; round < 20; ++round) {
+		for (int join = 0; join < 2; ++join) {
+			std::vector<double> m = test::randomDbm<double>(n, 0.6, 0, 20, true);
+			ukoct::CpuState<double>* state = test::newState(impl, m);
+			ukoct::CpuState<double>* pairwise = test::newState(impl, m);
+			ukoct::OctDbm<double> dbm(state);
+			std::vector<ukoct::OctDbm<double>*> owned;
+			std::vector<const ukoct::OctDbm<double>*> others;
+			for (int s = rand() % 4; s >= 0; --s) {
+				ukoct::CpuState<double>* other = test::newState(impl, test::randomDbm<double>(n, 0.6, 0, 20, true), rand() % 2 == 0);
+				test::run(impl, join ? ukoct::OPER_UNION : ukoct::OPER_INTERSECTION, *pairwise, other);
+				owned.push_back(new ukoct::OctDbm<double>(other));
+				others.push_back(owned.back());
+			}
+
+			if (join)
+				dbm &= others;
+			else
+				dbm |= others;
+			test::check(test::matrix(*state) == test::matrix(*pairwise), join ? "joined DBMs" : "intersected DBMs");
+			std::vector<const ukoct::OctDbm<double>*> none;
+			dbm &= none;
+			test::check(test::matrix(*state) == test::matrix(*pairwise), "joined with no DBMs");
+
+			for (size_t s = 0; s < owned.size(); ++s)
+				delete owned[s];
+			delete pairwise;
+		}
+	}
+}
+
+
+int main(void) {
+	srand(24);
+	ukoct::CpuImplementation<double> sequential;
+	ukoct::CpuImplementation<double> parallel(4);
+	ukoct::EOperation operations[] = { ukoct::OPER_UNION, ukoct::OPER_INTERSECTION };
+	for (size_t i = 0; i < 2; ++i) {
+		ukoct::IOperator<double>* op = sequential.newOperator(operations[i], 0);
+		test::check((op->details().impl() & ukoct::O_IMPL_NARY) != 0, "n-ary operator");
+		delete op;
+	}
+	nary(sequential, 8, 40);
+	nary(parallel, 8, 20);
+	nary(parallel, 2 * ukoct_CPU_PARALLELSIZE + 2, 4);
+	dbms(sequential);
+	return test::result();
+}
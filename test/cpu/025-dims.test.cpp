@@ -0,0 +1,142 @@
+#include <cstdlib>
+#include <limits>
+#include "common.hpp"
+
+typedef std::vector<plas::var_t> Vars;
+static const size_t none = std::numeric_limits<size_t>::max();
+
+
+/* Reference remapping of the variables of an n x n matrix, to[v] being the 0-based new place of v, or none. */
+std::vector<double> remap(const std::vector<double>& m, size_t n, const std::vector<size_t>& to, size_t octSize) {
+	size_t size = 2 * octSize;
+	std::vector<double> r(size * size, std::numeric_limits<double>::infinity());
+	for (size_t i = 0; i < size; ++i)
+		r[i * size + i] = 0;
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (to[i / 2] != none && to[j / 2] != none)
+				r[(2 * to[i / 2] + i % 2) * size + 2 * to[j / 2] + j % 2] = m[i * n + j];
+	return r;
+}
+
+
+/* Runs a dims operator, telling whether it threw an ukoct::Error. */
+bool throws(ukoct::CpuImplementation<double>& impl, ukoct::EOperation operation, ukoct::IState<double>& state, const Vars& vars) {
+	ukoct::IOperator<double>* op = impl.newOperator(operation);
+	ukoct::OperatorArgs<double> args(state);
+	args.vars(&vars);
+	bool thrown = false;
+	try {
+		op->run(args);
+		op->wait();
+	} catch (ukoct::Error&) {
+		thrown = true;
+	}
+	delete op;
+	return thrown;
+}
+
+
+/*
+ * Removing, adding and permuting the variables of a 4-variable DBM, where
+ * variables 1 and 2 are related, and so are 3 and 4.
+ */
+void dims(bool rowMajor) {
+	ukoct::CpuImplementation<double> impl;
+	double inf = std::numeric_limits<double>::infinity();
+	size_t n = 8;
+	std::vector<double> m(n * n, inf);
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (i == j || i / 4 == j / 4)
+				m[i * n + j] = double(i == j ? 0 : i * n + j);
+
+	for (int operation = 0; operation < 3; ++operation) {
+		Vars vars;
+		std::vector<size_t> to;
+		size_t octSize = 0;
+		ukoct::EOperation oper = ukoct::OPER_REMOVEDIMS;
+		if (operation == 0) {
+			// Removes the second variable, given negated
+			vars.push_back(-2);
+			to.push_back(0); to.push_back(none); to.push_back(1); to.push_back(2);
+			octSize = 3;
+		} else if (operation == 1) {
+			// New variables go 2nd and 5th
+			vars.push_back(5);
+			vars.push_back(2);
+			to.push_back(0); to.push_back(2); to.push_back(3); to.push_back(5);
+			octSize = 6;
+			oper = ukoct::OPER_ADDDIMS;
+		} else {
+			vars.push_back(3); vars.push_back(1); vars.push_back(4); vars.push_back(2);
+			to.push_back(2); to.push_back(0); to.push_back(3); to.push_back(1);
+			octSize = 4;
+			oper = ukoct::OPER_PERMUTEDIMS;
+		}
+
+		ukoct::CpuState<double>* state = test::newState(impl, m, rowMajor);
+		state->partition(true);
+		state->flags().set(ukoct::impl::cpu::CPUSTATE_CLOSED, true);
+		state->flags().set(ukoct::impl::cpu::CPUSTATE_TIGHTLYCLOSED, false);
+		ukoct::OperatorArgs<double> args(*state);
+		args.vars(&vars);
+		test::run(impl, oper, args);
+
+		test::check(state->diffSize() == 2 * octSize && state->rowMajor() == rowMajor, "size or ordering of the result");
+		test::check(test::matrix(*state) == remap(m, n, to, octSize), "remapped matrix");
+		test::check(state->flags().holds(ukoct::impl::cpu::CPUSTATE_CLOSED), "flag which holds lost");
+		if (operation == 0)
+			test::check(!state->flags().known(ukoct::impl::cpu::CPUSTATE_TIGHTLYCLOSED), "flag which fails kept after removing variables");
+		else
+			test::check(state->flags().fails(ukoct::impl::cpu::CPUSTATE_TIGHTLYCLOSED), "flag which fails lost");
+
+		// Components follow their variables, new ones are of their own
+		ukoct::impl::cpu::CpuPartition& partition = state->partition(false);
+		test::check(partition.valid() && partition.size() == octSize, "partition lost");
+		if (partition.valid() && partition.size() == octSize) {
+			std::vector<size_t> from(octSize, none);
+			for (size_t v = 0; v < to.size(); ++v)
+				if (to[v] != none)
+					from[to[v]] = v;
+			for (size_t u = 0; u < octSize; ++u)
+				for (size_t v = 0; v < octSize; ++v)
+					test::check((partition.find(u) == partition.find(v)) == (u == v || (from[u] != none && from[v] != none && from[u] / 2 == from[v] / 2)), "partition of the result");
+		}
+		delete state;
+	}
+}
+
+
+/* Invalid variables throw, and leave the state as it was. */
+void invalid() {
+	ukoct::CpuImplementation<double> impl;
+	std::vector<double> m(8 * 8, 1);
+	for (size_t i = 0; i < 8; ++i)
+		m[i * 8 + i] = 0;
+	ukoct::CpuState<double>* state = test::newState(impl, m);
+
+	Vars outOfRange(1, 5), all, shortPermutation(3, 1), repeated;
+	for (plas::var_t v = 1; v <= 4; ++v)
+		all.push_back(-v);
+	repeated.push_back(1); repeated.push_back(2); repeated.push_back(2); repeated.push_back(3);
+
+	test::check(throws(impl, ukoct::OPER_REMOVEDIMS, *state, outOfRange), "removing a variable out of range");
+	test::check(throws(impl, ukoct::OPER_REMOVEDIMS, *state, all), "removing all the variables");
+	test::check(throws(impl, ukoct::OPER_ADDDIMS, *state, Vars(1, 0)), "adding a variable at 0");
+	test::check(throws(impl, ukoct::OPER_ADDDIMS, *state, Vars(1, 6)), "adding a variable out of range");
+	test::check(throws(impl, ukoct::OPER_ADDDIMS, *state, Vars(2, 3)), "adding variables at the same place");
+	test::check(throws(impl, ukoct::OPER_PERMUTEDIMS, *state, shortPermutation), "permuting with too few places");
+	test::check(throws(impl, ukoct::OPER_PERMUTEDIMS, *state, repeated), "permuting with repeated places");
+	test::check(throws(impl, ukoct::OPER_PERMUTEDIMS, *state, Vars(4, 5)), "permuting out of range");
+	test::check(test::matrix(*state) == m, "matrix changed by an invalid operation");
+	delete state;
+}
+
+
+int main(void) {
+	dims(true);
+	dims(false);
+	invalid();
+	return test::result();
+}
@@ -0,0 +1,124 @@
+#ifndef UKOCT_TEST_CPU_COMMON_HPP_
+#define UKOCT_TEST_CPU_COMMON_HPP_
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "ukoct/cpu.hpp"
+
+/*
+ * Helpers shared by the CPU implementation tests. Matrices are given and
+ * returned as row-major n x n vectors, whatever the ordering of the state.
+ */
+namespace test {
+
+static int failures = 0;
+
+
+inline void check(bool cond, const char* what) {
+	if (!cond) {
+		std::cout << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+
+inline int result() {
+	std::cout << (failures == 0 ? "OK" : "FAILED") << std::endl;
+	return failures == 0 ? 0 : 1;
+}
+
+
+template <typename T> void setup(ukoct::IState<T>& state, const std::vector<T>& m, bool rowMajor = true) {
+	size_t n = 0;
+	while (n * n < m.size())
+		++n;
+	std::vector<T> raw(m);
+	if (!rowMajor)
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				raw[j * n + i] = m[i * n + j];
+	state.setup(n, &raw[0], rowMajor);
+}
+
+
+template <typename T> ukoct::CpuState<T>* newState(ukoct::CpuImplementation<T>& impl, const std::vector<T>& m, bool rowMajor = true) {
+	ukoct::CpuState<T>* state = impl.newState();
+	setup(*state, m, rowMajor);
+	return state;
+}
+
+
+template <typename T> std::vector<T> matrix(const ukoct::IState<T>& state) {
+	size_t n = state.diffSize();
+	std::vector<T> raw(n * n);
+	std::vector<T> m(n * n);
+	state.copyTo(&raw[0]);
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			m[i * n + j] = state.rowMajor() ? raw[i * n + j] : raw[j * n + i];
+	return m;
+}
+
+
+template <typename T> bool run(const ukoct::IImplementation<T>& impl, ukoct::EOperation operation, const ukoct::OperatorArgs<T>& args, ukoct::OperationDetails details = 0) {
+	ukoct::IOperator<T>* op = impl.newOperator(operation, details);
+	op->run(args);
+	op->wait();
+	bool ret = op->boolResult();
+	delete op;
+	return ret;
+}
+
+
+/*
+ * A random n x n DBM, with a diagonal of 0, and entries in [lo, hi] or,
+ * with probability 1 - density, infinite. Coherent ones have
+ * m[ij] == m[J I].
+ */
+template <typename T> std::vector<T> randomDbm(size_t n, double density, int lo, int hi, bool coherent, T inf = std::numeric_limits<T>::infinity()) {
+	std::vector<T> m(n * n);
+	for (size_t i = 0; i < n * n; ++i)
+		m[i] = rand() < density * RAND_MAX ? T(lo + rand() % (hi - lo + 1)) : inf;
+	if (coherent)
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				m[(j ^ 1) * n + (i ^ 1)] = m[i * n + j];
+	for (size_t i = 0; i < n; ++i)
+		m[i * n + i] = 0;
+	return m;
+}
+
+
+/* Floyd-Warshall closure of a row-major n x n matrix of floating point T, telling whether it has no negative cycle. */
+template <typename T> bool shortestPath(std::vector<T>& m, size_t n) {
+	for (size_t k = 0; k < n; ++k)
+		for (size_t i = 0; i < n; ++i)
+			for (size_t j = 0; j < n; ++j)
+				m[i * n + j] = std::min(m[i * n + j], m[i * n + k] + m[k * n + j]);
+	for (size_t i = 0; i < n; ++i)
+		if (m[i * n + i] < 0)
+			return false;
+	return true;
+}
+
+
+/* Strengthening of a row-major n x n matrix of floating point T, m[ij] = min(m[ij], (m[iI] + m[Jj]) / 2). */
+template <typename T> void strengthen(std::vector<T>& m, size_t n) {
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+			m[i * n + j] = std::min(m[i * n + j], (m[i * n + (i ^ 1)] + m[(j ^ 1) * n + j]) / 2);
+}
+
+
+template <typename T> bool run(const ukoct::IImplementation<T>& impl, ukoct::EOperation operation, ukoct::IState<T>& state, ukoct::IState<T>* other = NULL) {
+	ukoct::OperatorArgs<T> args(state);
+	args.other(other);
+	return run(impl, operation, args);
+}
+
+}
+
+#endif /* UKOCT_TEST_CPU_COMMON_HPP_ */
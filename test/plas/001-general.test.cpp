@@ -30,7 +30,7 @@ int main(void) {
 	std::cout << problem;
 	std::cout << *problem.matrix();
 	std::cout << std::endl << "* Transforming..." << std::endl << std::endl;
-	plas::toOctDiffProblem(problem, transformedProblem);
+	plas::toOctDiffProblem(problem, transformedProblem, &std::clog);
 	std::cout << transformedProblem;
 	std::cout << *transformedProblem.matrix();
 	return 0;
@@ -0,0 +1,120 @@
+#include "common.hpp"
+
+
+/* Binary files hold the same problem as the text ones they're saved from. */
+template <typename T> void roundTrip() {
+	const char* text = "015-binary.txt";
+	const char* binary = "015-binary.plas";
+
+	for (int round = 0; round < 10; ++round) {
+		std::string source = test::randomOct(20 + rand() % 20, round % 3 != 0);
+		std::istringstream is(source);
+		plas::Problem<T> problem;
+		test::check(plas::open(is, problem), "text problem");
+		test::check(plas::saveBinary(binary, problem), "saved binary");
+
+		plas::Problem<T> loaded;
+		test::check(plas::openBinary(binary, loaded), "binary problem");
+		test::check(test::describe(loaded) == test::describe(problem), "binary problem differs");
+		test::check(test::describe(*loaded.matrix(), 4) == test::describe(*problem.matrix(), 4), "binary problem matrix differs");
+
+		// Binary files are told apart by open()
+		plas::Problem<T> detected;
+		test::check(plas::open(binary, detected) && test::describe(detected) == test::describe(problem), "binary file not detected");
+		test::write(text, source);
+		plas::Problem<T> fromText;
+		test::check(plas::open(text, fromText) && test::describe(fromText) == test::describe(problem), "text file");
+
+		test::check(plas::convertToBinary<T>(text, binary), "converted to binary");
+		plas::Problem<T> converted;
+		test::check(plas::openBinary(binary, converted) && test::describe(converted) == test::describe(problem), "converted problem differs");
+
+		// Octagonal differences, loaded straight into a matrix
+		plas::Problem<T> diff;
+		test::check(plas::toOctDiffProblem(problem, diff), "octdiff problem");
+		plas::var_t size = diff.numVars();
+		diff.declaredNumVars(size);
+		test::check(plas::saveBinary(binary, diff), "saved octdiff binary");
+		plas::DenseMatrix<T> matrix;
+		if (plas::loadBinaryMatrix(binary, matrix) && matrix.rowsize() == size)
+			test::check(test::describe(matrix, size) == test::describe(*diff.matrix(), size), "binary matrix differs");
+		else
+			test::check(false, "binary matrix");
+
+		// Matrices which can't be resized are loaded into when large enough
+		test::check(plas::loadBinaryMatrix(binary, matrix) && test::describe(matrix, size) == test::describe(*diff.matrix(), size), "binary matrix of the same size");
+		std::vector<T> raw(size * size, std::numeric_limits<T>::infinity());
+		plas::DenseMatrix<T> rawMatrix(&raw[0], size, size, plas::MATRIX_ROWMAJOR);
+		test::check(plas::loadBinaryMatrix(binary, rawMatrix) && test::describe(rawMatrix, size) == test::describe(*diff.matrix(), size), "binary matrix over a raw buffer");
+		if (size > 1) {
+			plas::DenseMatrix<T> smallMatrix(&raw[0], size - 1, size - 1, plas::MATRIX_ROWMAJOR);
+			test::check(!plas::loadBinaryMatrix(binary, smallMatrix), "binary matrix too small");
+		}
+	}
+	std::remove(text);
+	std::remove(binary);
+}
+
+
+/* Files which aren't binary files of the right element type are rejected. */
+void invalid() {
+	const char* binary = "015-invalid.plas";
+	std::istringstream is(test::randomOct(10));
+	plas::Problem<double> problem;
+	plas::open(is, problem);
+	plas::saveBinary(binary, problem);
+
+	plas::Problem<float> floats;
+	test::check(!plas::openBinary(binary, floats), "binary file of another type");
+	plas::Problem<int> ints;
+	test::check(!plas::openBinary(binary, ints), "binary file of another kind");
+	plas::DenseMatrix<float> matrix;
+	test::check(!plas::loadBinaryMatrix(binary, matrix), "binary matrix of another type");
+
+	std::string bytes;
+	{
+		std::ifstream in(binary, std::ios::binary);
+		bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	for (int corruption = 0; corruption < 7; ++corruption) {
+		std::string corrupt(bytes);
+		plas::BinaryHeader& header = *reinterpret_cast<plas::BinaryHeader*>(&corrupt[0]);
+		if (corruption == 0)
+			header.version = plas::BinaryHeader::currentVersion + 1;
+		else if (corruption == 1)
+			header.numEntries += 1000;
+		else if (corruption == 2)
+			header.entriesOffset += 1;
+		else if (corruption == 3)
+			corrupt.resize(corrupt.size() - 2);
+		else if (corruption == 4)
+			header.declaredNumVars = 0;
+		else
+			// Variables out of the declared ones would be written out of the matrix
+			reinterpret_cast<plas::BinaryEntry<double>*>(&corrupt[header.entriesOffset])->a = corruption == 5 ? 5 : -5;
+		test::write(binary, corrupt);
+
+		plas::Problem<double> loaded;
+		test::check(!plas::openBinary(binary, loaded), "corrupt binary file");
+	}
+
+	// Problems with entries out of their declared variables aren't saved
+	std::istringstream undeclared("p oct 2\ne 1 3 5\n");
+	plas::Problem<double> tooMany;
+	plas::open(undeclared, tooMany);
+	test::check(!plas::saveBinary(binary, tooMany), "saved entries out of the declared variables");
+
+	std::remove(binary);
+	plas::Problem<double> missing;
+	test::check(!plas::openBinary(binary, missing), "missing binary file");
+}
+
+
+int main(void) {
+	srand(15);
+	roundTrip<double>();
+	roundTrip<float>();
+	invalid();
+	return test::result();
+}
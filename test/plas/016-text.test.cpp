@@ -0,0 +1,157 @@
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "common.hpp"
+
+
+/* Constants are parsed as istream would, and exactly when they're short. */
+template <typename T> void numbers() {
+	for (int round = 0; round < 2000; ++round) {
+		std::ostringstream os;
+		if (rand() % 3 == 0)
+			os << "-";
+		os << rand() % 100000;
+		if (rand() % 2)
+			os << "." << rand() % 1000;
+		if (round % 10 == 0)
+			os << "e" << rand() % 20 - 10;
+		std::string s = os.str();
+
+		T expected;
+		std::istringstream(s) >> expected;
+		T value = 0;
+		plas::Tokenizer tokens(s.data(), s.data() + s.size());
+		test::check(tokens.parse(value) && tokens.atEnd() && value == expected, "parsed constant");
+	}
+
+	const char* invalid[] = { "", "x", "-", ".", "e5" };
+	for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+		T value = 0;
+		plas::Tokenizer tokens(invalid[i], invalid[i] + std::strlen(invalid[i]));
+		test::check(!tokens.parse(value), "invalid constant parsed");
+	}
+}
+
+
+/* Integers are parsed up to their limits, and no further. */
+void integers() {
+	const char* source = " 2147483647 -2147483648\t+7 2147483648 -x 2.5";
+	plas::Tokenizer tokens(source, source + std::strlen(source));
+	int value = 0;
+	test::check(tokens.parse(value) && value == std::numeric_limits<int>::max(), "largest integer");
+	test::check(tokens.parse(value) && value == std::numeric_limits<int>::min(), "smallest integer");
+	test::check(tokens.parse(value) && value == 7, "signed integer");
+	test::check(!tokens.parse(value), "integer overflow");
+	tokens.skipToken();
+	test::check(!tokens.parse(value) && !tokens.atEnd(), "invalid integer");
+	tokens.skipToken();
+	test::check(!tokens.parse(value) && !tokens.atEnd(), "integer part of a real parsed");
+	unsigned int u = 0;
+	const char* negative = "-1";
+	plas::Tokenizer unsignedTokens(negative, negative + 2);
+	test::check(!unsignedTokens.parse(u), "negative unsigned integer");
+}
+
+
+/* Lines are split alike whatever the block size, and whether the stream ends with a newline. */
+void lines() {
+	std::string source;
+	std::vector<std::string> expected;
+	for (int i = 0; i < 200; ++i) {
+		std::string line(rand() % 40, 'a' + i % 26);
+		expected.push_back(line);
+		source += line + "\n";
+	}
+
+	for (size_t blockSize = 1; blockSize <= 64; blockSize *= 4) {
+		for (int trailing = 0; trailing < 2; ++trailing) {
+			std::string s = trailing ? source : source.substr(0, source.size() - 1);
+			std::istringstream is(s);
+			plas::LineReader reader(is, blockSize);
+			const char* begin;
+			const char* end;
+			std::vector<std::string> got;
+			while (reader.next(begin, end))
+				got.push_back(std::string(begin, end));
+			// A last empty line without its newline can't be told from the end of the stream
+			if (!trailing && expected.back().empty())
+				got.push_back("");
+			test::check(got == expected, "lines");
+		}
+	}
+}
+
+
+/* A 4-variable problem, with comments, names and both kinds of constraints. */
+void problem() {
+	std::istringstream is(
+		"# A comment\n"
+		"\n"
+		"p oct_int 4 8\n"
+		"e 1 2 3\n"
+		"  e -1   -3\t2.5\r\n"
+		"e 4 -7.5\n"
+		"e 2 x 1\n"
+		"n 1 first\n"
+		"n 4 last  \n"
+		"# e 3 3 3\n"
+		"e -4 2 -1e1\n");
+	plas::Problem<double> problem;
+	test::check(plas::open(is, problem), "problem");
+	test::check(problem.problemType() == plas::PROBLEM_OCT && problem.problemNature() == plas::PROBLEM_INT, "problem type");
+	test::check(problem.declaredNumVars() == 4 && problem.declaredNumEntries() == 8 && problem.numVars() == 4, "problem sizes");
+	test::check(problem.entries().size() == 4, "problem entries");
+	test::check(problem.minConstant() == -10 && problem.maxConstant() == 3, "problem constants");
+
+	if (problem.entries().size() == 4) {
+		plas::OctDiffConstraint<double>& e0 = problem.entry(0).octConstraint();
+		plas::OctDiffConstraint<double>& e1 = problem.entry(1).octConstraint();
+		plas::OctDiffConstraint<double>& e2 = problem.entry(2).octConstraint();
+		plas::OctDiffConstraint<double>& e3 = problem.entry(3).octConstraint();
+		test::check(e0.a() == 1 && e0.b() == 2 && e0.constant() == 3 && problem.entry(0).fileline() == 4, "first entry");
+		test::check(e1.a() == -1 && e1.b() == -3 && e1.constant() == 2.5 && problem.entry(1).fileline() == 5, "second entry");
+		test::check(e2.isSingleVar() && e2.a() == 4 && e2.constant() == -7.5, "single variable entry");
+		test::check(e3.a() == -4 && e3.b() == 2 && e3.constant() == -10 && problem.entry(3).fileline() == 11, "last entry");
+	}
+
+	plas::NameTable& names = *problem.names();
+	test::check(names.size() == 2 && names.find(1) != plas::NameTable::npos && names.find(4) != plas::NameTable::npos, "names");
+	if (names.size() == 2) {
+		test::check(names.name(names.find(1)) == "first" && names.fileline(names.find(1)) == 8, "first name");
+		test::check(names.name(names.find(4)) == "last", "last name");
+	}
+	test::check(problem.vars()->size() == 6 && problem.vars()->count(-4) == 1 && problem.vars()->count(4) == 1, "problem vars");
+
+	// Lines before the problem line, and invalid problem lines, are ignored
+	std::istringstream invalid("e 1 2 3\nn 1 x\np oct x\ne 1 2 3\n");
+	test::check(!plas::open(invalid, problem) && problem.entries().empty() && problem.names()->empty(), "invalid problem");
+}
+
+
+/* Random 4-variable problems parsed from files and streams alike. */
+void files() {
+	const char* path = "016-text.txt";
+	for (int round = 0; round < 20; ++round) {
+		std::string source = test::randomOct(rand() % 50, round % 2 == 0);
+		std::istringstream is(source);
+		plas::Problem<float> fromStream;
+		plas::open(is, fromStream);
+		test::write(path, source);
+		plas::Problem<float> fromFile;
+		test::check(plas::open(path, fromFile) && fromFile.filename() == path, "problem file");
+		test::check(test::describe(fromFile) == test::describe(fromStream), "problem file differs");
+	}
+	std::remove(path);
+}
+
+
+int main(void) {
+	srand(16);
+	numbers<double>();
+	numbers<float>();
+	integers();
+	lines();
+	problem();
+	files();
+	return test::result();
+}
@@ -0,0 +1,88 @@
+#include "common.hpp"
+
+
+/*
+ * A large text problem over 4 variables, so that it's split into chunks,
+ * with `e` lines before its problem line and names all over it.
+ */
+std::string largeOct(size_t numEntries, size_t problemLine, bool secondProblem) {
+	std::string source;
+	for (size_t i = 0; i < numEntries; ++i) {
+		if (i == problemLine)
+			source += "p oct 4\n";
+		if (secondProblem && i == numEntries / 2)
+			source += "p oct 4\n";
+		if (i % 50000 == 7) {
+			std::ostringstream name;
+			name << "n " << i % 4 + 1 << " v" << i << "\n";
+			source += name.str();
+		}
+		if (i % 1000 == 3)
+			source += "# comment\n\n";
+		std::ostringstream entry;
+		entry << "e " << rand() % 4 + 1;
+		if (i % 5 != 0)
+			entry << (rand() % 2 ? " -" : " ") << rand() % 4 + 1;
+		entry << " " << (rand() % 40 - 10) / 2.0 << "\n";
+		source += entry.str();
+	}
+	return source;
+}
+
+
+/* Chunked parsing gives the same problems as sequential parsing, with any number of threads. */
+void chunks() {
+	const char* path = "017-parallel.txt";
+	size_t numEntries = 300000;
+	size_t problemLines[] = { 0, 1234, 200001 };
+
+	for (int round = 0; round < 4; ++round) {
+		std::string source = largeOct(numEntries, problemLines[round % 3], round == 3);
+		test::write(path, source);
+		plas::Problem<double> expected;
+		bool result = plas::open(path, expected);
+		test::check(expected.entries().size() == numEntries - (round == 3 ? 0 : problemLines[round % 3]), "sequential entries");
+
+		size_t threads[] = { 1, 2, 3, 8, 0 };
+		for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+			plas::Problem<double> problem;
+			test::check(plas::openParallel(path, problem, threads[t]) == result, "parallel result");
+			test::check(test::describe(problem) == test::describe(expected), "parallel problem differs");
+			for (size_t i = 0; i < expected.entries().size() && i < problem.entries().size(); i += 997)
+				test::check(problem.entry(i).fileline() == expected.entry(i).fileline(), "parallel entry line");
+			test::check(test::describe(*problem.matrix(), 4) == test::describe(*expected.matrix(), 4), "parallel matrix differs");
+			test::check(problem.filename() == path, "parallel filename");
+		}
+	}
+	std::remove(path);
+}
+
+
+/* Small, binary and missing files are opened as open() would. */
+void fallbacks() {
+	const char* path = "017-small.txt";
+	const char* binary = "017-small.plas";
+	std::string source = test::randomOct(40);
+	test::write(path, source);
+	plas::Problem<float> expected;
+	plas::open(path, expected);
+	plas::Problem<float> problem;
+	test::check(plas::openParallel(std::string(path), problem, 4) && test::describe(problem) == test::describe(expected), "small file");
+
+	plas::saveBinary(binary, expected);
+	plas::Problem<float> fromBinary;
+	test::check(plas::openParallel(binary, fromBinary, 4) && test::describe(fromBinary) == test::describe(expected), "binary file");
+
+	std::remove(path);
+	std::remove(binary);
+	plas::Problem<float> missing;
+	test::check(!plas::openParallel(path, missing, 4), "missing file");
+}
+
+
+int main(void) {
+	srand(17);
+	chunks();
+	fallbacks();
+	return test::result();
+}
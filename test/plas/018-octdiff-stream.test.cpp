@@ -0,0 +1,115 @@
+#include <vector>
+#include "common.hpp"
+
+
+/* A sink which checks the calls it gets, and keeps the tightest constants. */
+class CheckingSink : public plas::IOctDiffSink<double> {
+public:
+	CheckingSink() :
+		diffSize(0),
+		outOfBounds(0) {}
+
+
+	bool resize(plas::var_t size) {
+		diffSize = size;
+		m.assign(size * size, std::numeric_limits<double>::infinity());
+		return true;
+	}
+
+
+	void tighten(plas::var_t row, plas::var_t col, double d) {
+		if (row < 1 || col < 1 || row > diffSize || col > diffSize)
+			++outOfBounds;
+		else if (d < m[(row - 1) * diffSize + col - 1])
+			m[(row - 1) * diffSize + col - 1] = d;
+	}
+
+	plas::var_t diffSize;
+	size_t outOfBounds;
+	std::vector<double> m;
+};
+
+
+/* The tightest constant of each cell over the entries of an octdiff problem. */
+std::vector<double> tightest(plas::Problem<double>& diff, plas::var_t diffSize) {
+	std::vector<double> m(diffSize * diffSize, std::numeric_limits<double>::infinity());
+	for (size_t i = 0; i < diff.entries().size(); ++i) {
+		plas::OctDiffConstraint<double>& cons = diff.entry(i).octConstraint();
+		double& cell = m[(cons.a() - 1) * diffSize + cons.b() - 1];
+		cell = std::min(cell, cons.constant());
+	}
+	return m;
+}
+
+
+/* Streamed 4-variable oct problems give the matrix toOctDiffProblem() would, keeping the tightest constants. */
+void oct() {
+	for (int round = 0; round < 50; ++round) {
+		std::string source = test::randomOct(rand() % 60 + 1, round % 2 == 0);
+		source.replace(0, 7, "p oct 4 0");
+		std::istringstream is(source);
+		plas::Problem<double> problem;
+		plas::open(is, problem);
+		plas::Problem<double> diff;
+		plas::toOctDiffProblem(problem, diff);
+		std::vector<double> expected = tightest(diff, 8);
+
+		for (int keepEntries = 0; keepEntries < 2; ++keepEntries) {
+			std::istringstream streamed(source);
+			plas::Problem<double> header;
+			CheckingSink sink;
+			test::check(plas::openOctDiff(streamed, header, sink, keepEntries), "streamed problem");
+			test::check(sink.diffSize == 8 && sink.outOfBounds == 0, "streamed sizes");
+			test::check(sink.m == expected, "streamed matrix differs");
+			test::check(header.problemType() == plas::PROBLEM_OCT && header.declaredNumVars() == 4 && header.numVars() == problem.numVars(), "streamed declarations");
+			test::check(header.minConstant() == problem.minConstant() && header.maxConstant() == problem.maxConstant(), "streamed constants");
+			test::check(header.names()->size() == problem.names()->size() && *header.vars() == *problem.vars(), "streamed names and vars");
+			test::check(header.entries().size() == (keepEntries ? problem.entries().size() : 0), "streamed entries");
+			if (keepEntries)
+				test::check(test::describe(header) == test::describe(problem), "streamed entries differ");
+		}
+	}
+}
+
+
+/* Octdiff problems are streamed as they are, into any matrix, including one over a raw buffer. */
+void octdiff() {
+	double inf = std::numeric_limits<double>::infinity();
+	std::istringstream is(
+		"p octdiff 8\n"
+		"e 1 2 5\n"
+		"e 1 2 3\n"
+		"e 1 2 4\n"
+		"e 8 3 -1.5\n"
+		"e 9 1 0\n"
+		"e 4 0\n");
+	std::vector<double> raw(8 * 8, 0);
+	plas::DenseMatrix<double> matrix(&raw[0], 8, 8, plas::MATRIX_ROWMAJOR);
+	plas::MatrixOctDiffSink<double> sink(matrix);
+	plas::Problem<double> problem;
+	test::check(plas::openOctDiff(is, problem, sink), "octdiff problem");
+	test::check(problem.problemType() == plas::PROBLEM_OCTDIFF && problem.entries().empty(), "octdiff declarations");
+	test::check(raw[0 * 8 + 1] == 3 && raw[7 * 8 + 2] == -1.5 && raw[3 * 8 + 3] == 0, "octdiff cells");
+	size_t finite = 0;
+	for (size_t i = 0; i < raw.size(); ++i)
+		finite += raw[i] < inf ? 1 : 0;
+	test::check(finite == 3, "octdiff cells out of the matrix");
+
+	// Sinks refuse problems which don't fit, and problems must declare their size
+	std::vector<double> small(4 * 4);
+	plas::DenseMatrix<double> smallMatrix(&small[0], 4, 4, plas::MATRIX_ROWMAJOR);
+	plas::MatrixOctDiffSink<double> smallSink(smallMatrix);
+	std::istringstream tooLarge("p oct 4\ne 1 2 3\n");
+	test::check(!plas::openOctDiff(tooLarge, problem, smallSink), "problem too large for its sink");
+	CheckingSink checking;
+	std::istringstream undeclared("p oct\ne 1 2 3\n");
+	test::check(!plas::openOctDiff(undeclared, problem, checking), "problem of undeclared size");
+}
+
+
+int main(void) {
+	srand(18);
+	oct();
+	octdiff();
+	return test::result();
+}
@@ -0,0 +1,109 @@
+#include <map>
+#include "common.hpp"
+
+
+/* The variable index maps variables as a std::map would, whatever their values. */
+void index() {
+	for (int round = 0; round < 20; ++round) {
+		plas::VarIndex index;
+		std::map<plas::var_t, size_t> expected;
+		for (int i = 0; i < 500; ++i) {
+			plas::var_t var = round % 2 == 0 ? rand() % 64 - 32 : rand() * (rand() % 2 ? 1 : -1);
+			if (var == plas::INVALID_VAR)
+				continue;
+			size_t value = rand() % 1000;
+			index.insert(var, value);
+			expected[var] = value;
+		}
+		test::check(index.size() == expected.size(), "index size");
+
+		bool same = true;
+		for (plas::var_t var = -40; var <= 40; ++var)
+			if (var != plas::INVALID_VAR)
+				same = same && index.find(var) == (expected.count(var) ? expected[var] : plas::VarIndex::npos);
+		for (std::map<plas::var_t, size_t>::iterator it = expected.begin(); it != expected.end(); ++it)
+			same = same && index.find(it->first) == it->second;
+		test::check(same, "index lookups");
+
+		index.clear();
+		test::check(index.size() == 0 && index.find(expected.begin()->first) == plas::VarIndex::npos, "cleared index");
+	}
+}
+
+
+/* Names are numbered as they're first set, and renaming keeps their number. */
+void table() {
+	plas::NameTable names;
+	test::check(names.empty() && names.find(1) == plas::NameTable::npos, "empty table");
+	test::check(names.set(3, std::string("z"), 7) == 0 && names.set(-1, "negative", 3, 8) == 1 && names.set(4, std::string("w")) == 2, "name numbers");
+	test::check(names.set(3, std::string("renamed"), 9) == 0 && names.size() == 3, "renamed variable");
+	test::check(names.name(0) == "renamed" && names.var(0) == 3 && names.fileline(0) == 9, "renamed name");
+	test::check(names.name(names.find(-1)) == "neg" && names.fileline(names.find(-1)) == 8, "negative variable name");
+
+	// Derived names are put together from the name of their source, or its number
+	plas::NameTable derived;
+	derived.derive(1, 3, true, &names);
+	derived.derive(2, 3, false, &names);
+	derived.derive(5, 2, true, &names);
+	derived.derive(6, 2, false, NULL);
+	test::check(derived.size() == 4, "derived names");
+	test::check(derived.name(derived.find(1)) == "renamed__p3_1" && derived.name(derived.find(2)) == "renamed__n3_2", "derived names of a named variable");
+	test::check(derived.name(derived.find(5)) == "2__p2_5" && derived.name(derived.find(6)) == "2__n2_6", "derived names of an unnamed variable");
+	std::string appended("x:");
+	derived.appendName(derived.find(2), appended);
+	test::check(appended == "x:renamed__n3_2", "appended name");
+
+	names.clear();
+	test::check(names.empty() && names.find(3) == plas::NameTable::npos, "cleared table");
+	test::check(derived.name(derived.find(1)) == "renamed__p3_1", "derived names kept their source");
+}
+
+
+/* Converted 4-variable problems name each difference variable after the variable it comes from, and keep their names when saved. */
+void converted() {
+	const char* binary = "019-names.plas";
+	for (int round = 0; round < 20; ++round) {
+		std::istringstream is(test::randomOct(rand() % 30 + 1, round % 3 != 0));
+		plas::Problem<double> problem;
+		plas::open(is, problem);
+		plas::Problem<double> diff;
+		plas::toOctDiffProblem(problem, diff);
+
+		bool named = true;
+		plas::NameTable& names = *diff.names();
+		for (size_t i = 0; i < names.size(); ++i) {
+			plas::var_t var = names.var(i);
+			plas::var_t source = (var + 1) / 2;
+			std::ostringstream expected;
+			size_t idx = problem.names()->find(source);
+			if (idx != plas::NameTable::npos)
+				expected << problem.names()->name(idx);
+			else
+				expected << source;
+			expected << (var % 2 == 1 ? "__p" : "__n") << source << "_" << var;
+			named = named && var >= 1 && var <= 8 && names.name(i) == expected.str();
+		}
+		test::check(named, "converted names");
+		test::check(names.size() == diff.vars()->size(), "converted variables not named");
+
+		diff.declaredNumVars(diff.numVars());
+		plas::saveBinary(binary, diff);
+		plas::Problem<double> loaded;
+		bool same = plas::openBinary(binary, loaded) && loaded.names()->size() == names.size();
+		for (size_t i = 0; same && i < names.size(); ++i) {
+			size_t idx = loaded.names()->find(names.var(i));
+			same = idx != plas::NameTable::npos && loaded.names()->name(idx) == names.name(i);
+		}
+		test::check(same, "saved names differ");
+	}
+	std::remove(binary);
+}
+
+
+int main(void) {
+	srand(19);
+	index();
+	table();
+	converted();
+	return test::result();
+}
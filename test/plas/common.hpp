@@ -0,0 +1,98 @@
+#ifndef UKOCT_TEST_PLAS_COMMON_HPP_
+#define UKOCT_TEST_PLAS_COMMON_HPP_
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "plas.hpp"
+
+/*
+ * Helpers shared by the plas tests.
+ */
+namespace test {
+
+static int failures = 0;
+
+
+inline void check(bool cond, const char* what) {
+	if (!cond) {
+		std::cout << "FAILED: " << what << std::endl;
+		++failures;
+	}
+}
+
+
+inline int result() {
+	std::cout << (failures == 0 ? "OK" : "FAILED") << std::endl;
+	return failures == 0 ? 0 : 1;
+}
+
+
+/*
+ * A text `oct` problem over 4 variables, named x1 to x4, with `numEntries`
+ * random constraints of one or two variables. The number of constraints
+ * isn't declared, since open() fails when given as many as declared.
+ */
+inline std::string randomOct(size_t numEntries, bool names = true) {
+	std::ostringstream os;
+	os << "p oct 4\n";
+	for (size_t i = 0; i < numEntries; ++i) {
+		plas::var_t a = (rand() % 4 + 1) * (rand() % 2 ? 1 : -1);
+		plas::var_t b = (rand() % 4 + 1) * (rand() % 2 ? 1 : -1);
+		if (i % 5 == 0)
+			os << "e " << a << " " << (rand() % 40 - 10) / 2.0 << "\n";
+		else
+			os << "e " << a << " " << b << " " << (rand() % 40 - 10) / 2.0 << "\n";
+		if (i % 7 == 3)
+			os << "# comment\n\n";
+	}
+	if (names)
+		for (plas::var_t v = 1; v <= 4; ++v)
+			os << "n " << v << " x" << v << "\n";
+	return os.str();
+}
+
+
+/* Everything a problem was given, as text, for comparing problems. */
+template <typename T, template <typename> class M> std::string describe(plas::Problem<T, M>& problem) {
+	std::ostringstream os;
+	os << problem.problemType() << " " << problem.problemNature() << " " << problem.numVars() << " "
+		<< problem.declaredNumVars() << " " << problem.declaredNumEntries() << " "
+		<< problem.minConstant() << " " << problem.maxConstant() << "\n";
+	for (size_t i = 0; i < problem.entries().size(); ++i) {
+		plas::OctDiffConstraint<T>& cons = problem.entry(i).octConstraint();
+		os << "e " << problem.entry(i).index() << " " << cons.a() << " " << cons.b() << " " << cons.constant() << "\n";
+	}
+	if (problem.names() != NULL)
+		for (size_t i = 0; i < problem.names()->size(); ++i)
+			os << "n " << problem.names()->var(i) << " " << problem.names()->name(i) << "\n";
+	if (problem.vars() != NULL)
+		for (typename plas::Problem<T, M>::VarSetIterator it = problem.vars()->begin(); it != problem.vars()->end(); ++it)
+			os << "v " << *it << "\n";
+	return os.str();
+}
+
+
+/* The first `size` x `size` cells of a matrix, as text. */
+template <typename T> std::string describe(plas::IMatrix<T>& matrix, plas::var_t size) {
+	std::ostringstream os;
+	for (plas::var_t r = 1; r <= size; ++r) {
+		for (plas::var_t c = 1; c <= size; ++c)
+			os << matrix(r, c) << " ";
+		os << "\n";
+	}
+	return os.str();
+}
+
+
+inline void write(const char* path, const std::string& contents) {
+	std::ofstream os(path, std::ios::binary | std::ios::trunc);
+	os << contents;
+}
+
+}
+
+#endif /* UKOCT_TEST_PLAS_COMMON_HPP_ */